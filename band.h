@@ -0,0 +1,29 @@
+
+#ifndef _BAND_H
+#define _BAND_H
+
+#include "neslib.h"
+
+// Formation band scrolling on an MMC3 (mapper 4) scanline IRQ,
+// for FORMATION_IRQ builds (band.s). Each formation row gets
+// its own X scroll, set by an IRQ in the blank line above it;
+// a last IRQ puts the scroll back to 0 for the playfield.
+
+// counter value for the first split (which lands at the end
+// of scanline BAND_TOP-1, in the blank line above row 0), and
+// lines between splits (one formation row)
+#define BAND_TOP	19
+#define BAND_STEP	16
+
+// MMC3 setup: CHR RAM banks in order, horizontal mirroring,
+// IRQ off; then enables CPU IRQs (call first). The PRG banks
+// are mapped at reset (mmc3.s)
+void band_init(void);
+
+// NMI: latch this frame's row offsets and arm the first split
+void __fastcall__ band_nmi(void);
+
+// IRQ: set the next row's scroll and arm the split after it
+void __fastcall__ band_irq(void);
+
+#endif // band.h
@@ -0,0 +1,100 @@
+;
+; Formation band scroll splits on the MMC3 scanline IRQ
+; (see band.h). No busy-waiting: the CPU runs the game while
+; the IRQs land in the blank lines between formation rows.
+;
+; The MMC3 counts PPU A12 rises. Background tiles come from
+; $0000; with 8x16 sprites, any empty sprite slot fetches
+; tile $FF from $1000, so a line only goes uncounted when all
+; 8 of its sprites are in the $0000 table. The 8-line gaps
+; absorb that and the IRQ's latency.
+;
+; The splits read formation_row_x[] from shoot2.c: row r is
+; drawn at x = 0 and shown at formation_row_x[r].
+;
+
+.export _band_init, _band_nmi, _band_irq
+.import _formation_row_x
+
+PPU_STATUS	= $2002
+PPU_SCROLL	= $2005
+MMC3_SELECT	= $8000
+MMC3_BANK	= $8001
+MMC3_MIRROR	= $a000
+MMC3_LATCH	= $c000
+MMC3_RELOAD	= $c001
+MMC3_IRQ_OFF	= $e000		; also acknowledges
+MMC3_IRQ_ON	= $e001
+
+BAND_ROWS	= 4		; ENEMY_ROWS in shoot2.c
+BAND_TOP	= 19		; must match band.h
+BAND_STEP	= 16
+
+.segment "BSS"
+
+; X scroll for each split; the last stays 0
+band_x:		.res BAND_ROWS+1
+band_next:	.res 1		; next split
+
+.segment "CODE"
+
+; void band_init(void);
+_band_init:
+	ldx #5			; R0-R5; mmc3.s set the PRG banks
+@banks:
+	stx MMC3_SELECT
+	lda MMC3_BANKS,x
+	sta MMC3_BANK
+	dex
+	bpl @banks
+	lda #1
+	sta MMC3_MIRROR		; horizontal: rows wrap onto themselves
+	sta MMC3_IRQ_OFF
+	cli
+	rts
+
+; void __fastcall__ band_nmi(void);
+_band_nmi:
+	ldx #BAND_ROWS-1
+@rows:
+	lda _formation_row_x,x
+	eor #$ff		; scroll = -x
+	clc
+	adc #1
+	sta band_x,x
+	dex
+	bpl @rows
+	lda #0
+	sta band_next
+	lda #BAND_TOP
+	sta MMC3_LATCH
+	sta MMC3_RELOAD		; counter reloads on the pre-render line
+	sta MMC3_IRQ_OFF
+	sta MMC3_IRQ_ON
+	rts
+
+; void __fastcall__ band_irq(void);
+_band_irq:
+	sta MMC3_IRQ_OFF	; acknowledge
+	lda #BAND_STEP-1	; counter reloads from this next line
+	sta MMC3_LATCH
+	ldx band_next
+	bit PPU_STATUS		; reset the write toggle
+	lda band_x,x
+	sta PPU_SCROLL		; fine X now, coarse X next line
+	lda #0
+	sta PPU_SCROLL		; Y is ignored mid-frame
+	inx
+	stx band_next
+	cpx #BAND_ROWS+1
+	bcs @done		; the scroll is back to 0
+	sta MMC3_IRQ_ON
+@done:
+	rts
+
+.segment "RODATA"
+
+; R0-R1: 2K CHR at $0000/$0800, R2-R5: 1K at $1000-$1C00
+; (values in 1K units)
+MMC3_BANKS:
+	.byte 0, 2, 4, 5, 6, 7
@@ -1,3 +1,26 @@
 
-unsigned int bcd_add(unsigned int a, unsigned int b);
-unsigned int bcd_add2(unsigned int a, unsigned int b);
+#ifndef _BCD_H
+#define _BCD_H
+
+#include "neslib.h"
+
+// Packed BCD numbers of BCD_BYTES bytes, two digits a byte,
+// most significant byte first (so 123456 is 0x12,0x34,0x56).
+// The routines are in bcd.s.
+
+#define BCD_BYTES	3	// must match bcd.s
+#define BCD_DIGITS	(BCD_BYTES*2)
+
+// dst += src; sticks at all 9s instead of wrapping
+void __fastcall__ bcd_add(byte* dst, const byte* src);
+
+// dst += bcd, a 2-digit BCD byte (e.g. 0x25); sticks at all 9s
+void __fastcall__ bcd_add8(byte* dst, byte bcd);
+
+// -1, 0 or 1 as a is less than, equal to or greater than b
+signed char __fastcall__ bcd_cmp(const byte* a, const byte* b);
+
+// write BCD_DIGITS tiles, tile0 + digit, most significant first
+void __fastcall__ bcd_to_tiles(char* out, const byte* src, byte tile0);
+
+#endif // bcd.h
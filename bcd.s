@@ -0,0 +1,175 @@
+;
+; Packed BCD arithmetic for scores (see bcd.h).
+;
+; The 2A03 has no decimal mode, so each byte (two digits) goes
+; through BCD_TO_BIN, is added in binary, and comes back through
+; BIN_TO_BCD, whose entries 100-199 also mean "carry".
+; Numbers are BCD_BYTES long, most significant byte first, so
+; the add loop runs on DEY/BPL and the carry flag survives it.
+;
+; Cycles with BCD_BYTES = 3, JSR to RTS, not counting the caller
+; pushing arguments (measured on a 6502 model):
+;   bcd_add       218-264 (264 when it saturates)
+;   bcd_add8      110-242 (each byte the carry ripples into costs more)
+;   bcd_cmp        94-135
+;   bcd_to_tiles  307
+; The old C word bcd_add() for 4 digits takes 575 the same way.
+; That is the cc65 build of it in bin/shoot2.c.rom (the baseline
+; ROM) run on the same model; the C wasn't recompiled.
+;
+
+.export _bcd_add, _bcd_add8, _bcd_cmp, _bcd_to_tiles
+.import popax
+.importzp ptr1, ptr2, tmp1, tmp2, tmp3
+
+BCD_BYTES	= 3		; must match bcd.h
+
+.segment "CODE"
+
+; void __fastcall__ bcd_add(byte* dst, const byte* src);
+_bcd_add:
+	sta ptr2		; src
+	stx ptr2+1
+	jsr popax
+	sta ptr1		; dst
+	stx ptr1+1
+	ldy #BCD_BYTES-1
+	clc
+@loop:
+	lda (ptr2),y
+	tax
+	lda BCD_TO_BIN,x
+	sta tmp1
+	lda (ptr1),y
+	tax
+	lda BCD_TO_BIN,x
+	adc tmp1		; 0-199, C clear after
+	tax
+	lda BIN_TO_BCD,x
+	sta (ptr1),y
+	cpx #100		; C = carry into the next byte
+	dey
+	bpl @loop
+	bcs saturate
+	rts
+
+; void __fastcall__ bcd_add8(byte* dst, byte bcd);
+_bcd_add8:
+	tax
+	lda BCD_TO_BIN,x
+	sta tmp1
+	jsr popax
+	sta ptr1		; dst
+	stx ptr1+1
+	ldy #BCD_BYTES-1
+	clc
+@loop:
+	lda (ptr1),y
+	tax
+	lda BCD_TO_BIN,x
+	adc tmp1
+	tax
+	lda BIN_TO_BCD,x
+	sta (ptr1),y
+	cpx #100
+	bcc @done		; no carry, higher bytes unchanged
+	lda #0			; only the carry goes on
+	sta tmp1
+	dey
+	bpl @loop
+	bcs saturate		; always
+@done:
+	rts
+
+; out of digits: stick at all 9s
+saturate:
+	lda #$99
+	ldy #BCD_BYTES-1
+@loop:
+	sta (ptr1),y
+	dey
+	bpl @loop
+	rts
+
+; signed char __fastcall__ bcd_cmp(const byte* a, const byte* b);
+; packed BCD compares like unsigned binary, byte by byte
+_bcd_cmp:
+	sta ptr2		; b
+	stx ptr2+1
+	jsr popax
+	sta ptr1		; a
+	stx ptr1+1
+	ldy #0
+@loop:
+	lda (ptr1),y
+	cmp (ptr2),y
+	bne @differ
+	iny
+	cpy #BCD_BYTES
+	bne @loop
+	lda #0			; equal
+	tax
+	rts
+@differ:
+	ldx #0
+	lda #1			; a > b
+	bcs @done
+	dex			; a < b: -1
+	txa
+@done:
+	rts
+
+; void __fastcall__ bcd_to_tiles(char* out, const byte* src, byte tile0);
+; 2*BCD_BYTES tiles, tile0 + digit, most significant first
+_bcd_to_tiles:
+	sta tmp1		; tile0
+	jsr popax
+	sta ptr2		; src
+	stx ptr2+1
+	jsr popax
+	sta ptr1		; out
+	stx ptr1+1
+	ldy #0			; src index
+	sty tmp3		; out index
+@loop:
+	sty tmp2
+	lda (ptr2),y
+	tax
+	lsr
+	lsr
+	lsr
+	lsr
+	clc
+	adc tmp1
+	ldy tmp3
+	sta (ptr1),y
+	iny
+	txa
+	and #$0f
+	adc tmp1		; C still clear
+	sta (ptr1),y
+	iny
+	sty tmp3
+	ldy tmp2
+	iny
+	cpy #BCD_BYTES
+	bne @loop
+	rts
+
+.segment "RODATA"
+
+; packed BCD byte ($00-$99) -> 0-99
+BCD_TO_BIN:
+.repeat 10, hi
+  .repeat 16, lo
+    .if hi < 9 || lo < 10
+	.byte hi*10 + lo
+    .endif
+  .endrepeat
+.endrepeat
+
+; 0-199 -> packed BCD of n mod 100
+BIN_TO_BCD:
+.repeat 200, n
+	.byte ((n .mod 100) / 10) * 16 + (n .mod 10)
+.endrepeat
@@ -0,0 +1,184 @@
+
+// generated by tools/mkchr.py from tileset.h, do not edit
+
+// table 0 free tiles: 64-67,150-255
+// table 1 free tiles: 0-101,106-255
+// 1483 bytes packed
+
+#define CHR0_FIRST 0
+#define CHR0_1BPP_TILES 59
+// tiles 0..58, plane 0 only (plane 1 is zero)
+const byte CHR0_1BPP[472] = {
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x38,0x7C,0x7C,0x7C,0x38,0x00,0x38,0x00,
+  0x6C,0x6C,0x48,0x00,0x00,0x00,0x00,0x00,0x00,0x6C,0xFE,0x6C,0xFE,0x6C,0x00,0x00,
+  0x10,0xFE,0xD0,0xFE,0x16,0xFE,0x10,0x00,0x00,0xCE,0xDC,0x38,0x76,0xE6,0x00,0x00,
+  0x00,0x38,0x6C,0x7C,0xEC,0xEE,0x7E,0x00,0x38,0x38,0x30,0x00,0x00,0x00,0x00,0x00,
+  0x38,0x70,0x70,0x70,0x70,0x70,0x38,0x00,0x70,0x38,0x38,0x38,0x38,0x38,0x30,0x00,
+  0x00,0x00,0x6C,0x38,0x6C,0x00,0x00,0x00,0x00,0x38,0x38,0xFE,0x38,0x38,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x30,0x30,0x60,0x00,0x00,0x00,0x00,0x7C,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x60,0x60,0x00,0x0E,0x1E,0x3C,0x78,0xF0,0xE0,0x00,
+  0x00,0x7C,0xEE,0xEE,0xEE,0xEE,0x7C,0x00,0x00,0x38,0x78,0x38,0x38,0x38,0x7C,0x00,
+  0x00,0x7C,0x0E,0x7C,0xE0,0xEE,0xFE,0x00,0x00,0xFC,0x0E,0x3C,0x0E,0x0E,0xFC,0x00,
+  0x00,0x3E,0x7E,0xEE,0xEE,0xFE,0x0E,0x00,0x00,0xFC,0xE0,0xFC,0x0E,0xEE,0x7C,0x00,
+  0x00,0x7C,0xE0,0xFC,0xEE,0xEE,0x7C,0x00,0x00,0xFE,0xEE,0x1C,0x1C,0x38,0x38,0x00,
+  0x00,0x7C,0xEE,0x7C,0xEE,0xEE,0x7C,0x00,0x00,0x7C,0xEE,0xEE,0x7E,0x0E,0x3C,0x00,
+  0x00,0x60,0x60,0x00,0x00,0x60,0x60,0x00,0x00,0x60,0x60,0x00,0x00,0x60,0x60,0xC0,
+  0x00,0x1C,0x38,0x70,0x70,0x38,0x1C,0x00,0x00,0x00,0x7C,0x00,0x00,0x7C,0x00,0x00,
+  0x00,0x70,0x38,0x1C,0x1C,0x38,0x70,0x00,0x00,0x7C,0xEE,0x1C,0x38,0x00,0x38,0x00,
+  0x00,0x7C,0xEE,0xEE,0xEE,0xE0,0x7C,0x00,0x00,0x7C,0xEE,0xEE,0xEE,0xFE,0xEE,0x00,
+  0x00,0xFC,0xEE,0xFC,0xEE,0xEE,0xFC,0x00,0x00,0x7C,0xEE,0xE0,0xE0,0xEE,0x7C,0x00,
+  0x00,0xF8,0xEC,0xEE,0xEE,0xEE,0xFC,0x00,0x00,0xFE,0xE0,0xF0,0xE0,0xE0,0xFE,0x00,
+  0x00,0xFE,0xE0,0xF8,0xE0,0xE0,0xE0,0x00,0x00,0x7C,0xE0,0xEE,0xEE,0xEE,0x7E,0x00,
+  0x00,0xEE,0xEE,0xFE,0xEE,0xEE,0xEE,0x00,0x00,0x7C,0x38,0x38,0x38,0x38,0x7C,0x00,
+  0x00,0x0E,0x0E,0x0E,0x0E,0xEE,0x7C,0x00,0x00,0xEE,0xFC,0xF8,0xEC,0xEE,0xEE,0x00,
+  0x00,0xE0,0xE0,0xE0,0xE0,0xEE,0xFE,0x00,0x00,0xC6,0xEE,0xFE,0xFE,0xEE,0xEE,0x00,
+  0x00,0xCE,0xEE,0xFE,0xFE,0xEE,0xE6,0x00,0x00,0x7C,0xEE,0xEE,0xEE,0xEE,0x7C,0x00,
+  0x00,0xFC,0xEE,0xEE,0xEE,0xFC,0xE0,0x00,0x00,0x7C,0xEE,0xEE,0xEE,0xEC,0x7E,0x00,
+  0x00,0xFC,0xEE,0xEE,0xEE,0xFC,0xEE,0x00,0x00,0x7C,0xE0,0x7C,0x0E,0xEE,0x7C,0x00,
+  0x00,0xFE,0x38,0x38,0x38,0x38,0x38,0x00,0x00,0xEE,0xEE,0xEE,0xEE,0xEE,0x7C,0x00,
+  0x00,0xEE,0xEE,0xEE,0x6C,0x38,0x10,0x00,0x00,0xEE,0xEE,0xFE,0xFE,0xEE,0xC6,0x00,
+  0x00,0xEE,0x7C,0x38,0x7C,0xEE,0xEE,0x00,0x00,0xEE,0xEE,0xEE,0x7C,0x38,0x38,0x00,
+  0x00,0xFE,0x1C,0x38,0x70,0xE0,0xFE,0x00,
+};
+
+// tiles 59..149, vram_unrle() format
+const byte CHR0_RLE[974] = {
+  0x13,0x00,0x6C,0x92,0x82,0x82,0x44,0x28,0x10,0x00,0x6C,0xFE,0x13,0x02,0x7C,0x38,
+  0x10,0x00,0x6C,0x92,0x82,0x82,0x44,0x28,0x10,0x00,0x6C,0x92,0x82,0x82,0x44,0x28,
+  0x10,0x00,0x13,0x74,0x04,0x4C,0x78,0x00,0x13,0x02,0x01,0x02,0x02,0x03,0x06,0x30,
+  0x20,0x00,0x13,0x05,0x4A,0x50,0x20,0x00,0x13,0x09,0x10,0x19,0x0F,0x00,0x13,0x02,
+  0x40,0xA0,0xA0,0xE0,0x30,0x06,0x02,0x00,0x13,0x05,0x29,0x05,0x02,0x00,0x13,0x07,
+  0x40,0xE4,0x7C,0x70,0x00,0x13,0x03,0x01,0x02,0x82,0x8F,0x72,0x00,0x13,0x07,0x02,
+  0x00,0x13,0x0B,0x10,0x19,0x0F,0x00,0x13,0x02,0x40,0xA0,0xA0,0xE0,0x30,0x06,0x02,
+  0x00,0x13,0x05,0x29,0x05,0x02,0x00,0x13,0x06,0x60,0x30,0x3C,0x00,0x13,0x05,0x41,
+  0x42,0x3E,0x03,0x02,0x00,0x13,0x07,0x02,0x00,0x13,0x0B,0x10,0x1C,0x0E,0x00,0x13,
+  0x02,0x40,0xA0,0xA0,0xE0,0x30,0x06,0x03,0x03,0x00,0x13,0x04,0x28,0x04,0x04,0x03,
+  0x00,0x13,0x04,0x60,0x78,0x0C,0x04,0x00,0x13,0x05,0x71,0x0A,0x06,0x03,0x02,0x00,
+  0x13,0x07,0x02,0x00,0x13,0x0B,0x10,0x09,0x07,0x00,0x13,0x02,0x40,0xA0,0xA0,0xF0,
+  0x28,0x07,0x02,0x00,0x13,0x05,0x28,0x05,0x02,0x00,0x13,0x05,0x31,0x58,0x0C,0x04,
+  0x00,0x13,0x04,0x20,0x51,0x0A,0x06,0x03,0x02,0x00,0x13,0x07,0x02,0x00,0x13,0x07,
+  0x55,0x00,0x13,0x02,0x19,0x0F,0x06,0x00,0x13,0x02,0x40,0xA0,0xA0,0xF0,0x29,0x02,
+  0x00,0x13,0x06,0x25,0x02,0x00,0x13,0x06,0x80,0xC0,0x60,0x3C,0x00,0x13,0x05,0x81,
+  0x42,0x3E,0x03,0x02,0x00,0x13,0x07,0x02,0x00,0x13,0x07,0x01,0x01,0x03,0x06,0x1E,
+  0x0C,0x00,0x13,0x03,0x40,0xA1,0xA1,0xF2,0x2C,0x00,0x13,0x07,0x20,0x00,0x13,0x0A,
+  0x04,0x58,0x70,0x20,0x00,0x13,0x02,0x01,0x02,0x06,0x0B,0x52,0x00,0x13,0x07,0x22,
+  0x00,0x13,0x0A,0x10,0x0D,0x07,0x02,0x00,0x13,0x02,0x40,0xA0,0xB0,0xE8,0x25,0x00,
+  0x13,0x07,0x22,0x00,0x13,0x0A,0x10,0x10,0x03,0x07,0x00,0x13,0x03,0x03,0x0F,0x1F,
+  0x1F,0x24,0x40,0x00,0x00,0x07,0x63,0x41,0x00,0x3F,0x7F,0x13,0x02,0x78,0x00,0x13,
+  0x06,0x08,0x08,0xC0,0xE0,0x00,0x13,0x03,0xC0,0xF0,0xF8,0xF8,0x24,0x02,0x00,0x00,
+  0xE0,0xC6,0x82,0x00,0xFC,0xFE,0x13,0x02,0x1E,0x00,0x13,0x02,0x10,0x08,0x00,0x10,
+  0x08,0x5A,0x3C,0x5A,0x00,0x13,0x07,0x3C,0x24,0x18,0x00,0x13,0x0E,0x38,0x13,0x02,
+  0x00,0x13,0x04,0x10,0x38,0x10,0x00,0x00,0x04,0x00,0x00,0x80,0x10,0x38,0x10,0x00,
+  0x13,0x05,0x10,0x00,0x00,0x20,0x00,0x13,0x04,0x04,0x00,0x13,0x1C,0x08,0x00,0x13,
+  0x06,0x08,0x00,0x13,0x15,0x10,0x00,0x13,0x3F,0x08,0x04,0x03,0x06,0x05,0x00,0x13,
+  0x02,0x04,0x02,0x04,0x00,0x18,0x05,0x06,0x07,0x00,0x13,0x04,0x18,0x00,0x08,0x09,
+  0x00,0x13,0x06,0x08,0x90,0xE0,0x90,0xD0,0x00,0x13,0x02,0x10,0x20,0x10,0x00,0x0C,
+  0xF0,0x20,0xE0,0x80,0x00,0x13,0x03,0x0C,0x10,0x18,0x48,0x00,0x13,0x04,0x04,0x12,
+  0x0C,0x42,0x30,0x00,0x19,0x00,0x13,0x02,0x02,0x00,0x06,0x08,0x00,0x11,0x04,0x0C,
+  0x00,0x21,0x46,0x00,0x00,0x04,0x10,0x02,0x0C,0x00,0x13,0x04,0x40,0x08,0x91,0xA2,
+  0x04,0x80,0xCC,0x00,0x13,0x02,0x20,0x00,0x30,0x08,0x00,0xC4,0x10,0x1A,0x80,0x20,
+  0x10,0x00,0x00,0x10,0x04,0xA0,0x18,0x80,0x00,0x13,0x02,0x61,0x20,0x00,0x04,0x00,
+  0xC4,0x08,0x10,0x00,0x00,0x04,0x02,0x09,0x02,0x10,0x04,0x10,0x00,0x42,0xC8,0x80,
+  0x00,0x10,0x30,0x24,0x10,0x11,0x02,0x00,0x13,0x03,0x86,0xC4,0x00,0x10,0x01,0x10,
+  0x08,0x04,0x00,0x00,0x10,0x20,0x48,0x20,0x04,0x10,0x04,0x00,0x20,0x89,0x00,0x84,
+  0xC6,0x43,0x12,0x04,0x44,0x20,0x00,0x13,0x05,0x02,0x08,0x00,0x06,0x02,0x00,0x00,
+  0x40,0x08,0x01,0x11,0x11,0x00,0x38,0x30,0x02,0x00,0x13,0x05,0x08,0x00,0x10,0x00,
+  0x04,0x40,0x00,0x13,0x03,0x20,0x08,0x00,0x30,0x20,0x00,0x02,0x00,0x08,0x40,0x44,
+  0x44,0x00,0x0E,0x06,0x20,0x80,0x80,0x00,0x13,0x03,0x08,0x80,0x04,0x00,0x00,0x11,
+  0x00,0x13,0x03,0x40,0xE0,0xB0,0x08,0x00,0x13,0x02,0x44,0xA4,0x17,0x0D,0x05,0x02,
+  0x00,0x13,0x02,0x04,0x0E,0x1A,0x20,0x00,0x13,0x02,0x44,0x4A,0xD0,0x60,0x40,0x80,
+  0x00,0x13,0x02,0x20,0x70,0x58,0x04,0x00,0x13,0x02,0x22,0x52,0x0B,0x06,0x02,0x01,
+  0x00,0x13,0x02,0x02,0x07,0x0D,0x10,0x00,0x13,0x02,0x22,0x25,0xE8,0xB0,0xA0,0x40,
+  0x00,0x13,0x02,0x10,0x38,0x2C,0x02,0x00,0x13,0x02,0x11,0x29,0x05,0x03,0x01,0x00,
+  0x13,0x03,0x01,0x03,0x06,0x08,0x00,0x13,0x02,0x11,0x12,0xF4,0x58,0x50,0xA0,0x00,
+  0x13,0x03,0x80,0x80,0x00,0x13,0x04,0x80,0x00,0x13,0x06,0x08,0x1C,0x16,0x01,0x00,
+  0x13,0x02,0x08,0x14,0x02,0x01,0x00,0x13,0x05,0x01,0x03,0x04,0x00,0x13,0x02,0x88,
+  0x89,0xFA,0xAC,0xA8,0x50,0x00,0x13,0x02,0x80,0xC0,0x40,0x00,0x13,0x03,0x80,0x40,
+  0x00,0x13,0x06,0x04,0x0E,0x0B,0x00,0x13,0x03,0x04,0x0A,0x01,0x00,0x13,0x07,0x01,
+  0x82,0x00,0x13,0x02,0x44,0x44,0x7D,0xD6,0x54,0x28,0x00,0x13,0x02,0x40,0xE0,0xA0,
+  0x00,0x13,0x03,0x40,0xA0,0x00,0x13,0x06,0x02,0x07,0x05,0x00,0x13,0x03,0x02,0x05,
+  0x00,0x13,0x08,0x80,0x41,0x00,0x13,0x02,0x22,0x22,0xBE,0x6B,0x2A,0x14,0x00,0x13,
+  0x02,0x20,0x70,0xD0,0x00,0x13,0x03,0x20,0x50,0x80,0x00,0x13,0x05,0x01,0x03,0x02,
+  0x00,0x13,0x03,0x01,0x02,0x00,0x13,0x07,0x80,0xC0,0x20,0x00,0x13,0x02,0x11,0x91,
+  0x5F,0x35,0x15,0x0A,0x00,0x13,0x02,0x10,0x38,0x68,0x80,0x00,0x13,0x02,0x10,0x28,
+  0x40,0x80,0x00,0x13,0x05,0x01,0x01,0x00,0x13,0x04,0x01,0x00,0x13,0x06,0x80,0xC0,
+  0x60,0x10,0x00,0x13,0x02,0x88,0x48,0x2F,0x1A,0x0A,0x05,0x00,0x13,0x02,0x08,0x1C,
+  0x34,0x40,0x00,0x13,0x02,0x88,0x94,0xA0,0xC0,0x80,0x00,0x00,0x13,0x00,
+};
+
+#define CHR1_FIRST 102
+#define CHR1_1BPP_TILES 0
+#define CHR1_1BPP NULL
+
+// tiles 102..105, vram_unrle() format
+const byte CHR1_RLE[37] = {
+  0x01,0x00,0x00,0x38,0x01,0x02,0x00,0x01,0x04,0x10,0x38,0x10,0x00,0x00,0x04,0x00,
+  0x00,0x80,0x10,0x38,0x10,0x00,0x01,0x05,0x10,0x00,0x00,0x20,0x00,0x01,0x04,0x04,
+  0x00,0x01,0x19,0x01,0x00,
+};
+
+// formation tile names for each pixel phase (left, middle, right)
+const byte CHR_PHASE0[8] = { 128, 130, 132, 135, 138, 141, 144, 147 };
+const byte CHR_PHASE1[8] = { 129, 131, 133, 136, 139, 142, 145, 148 };
+const byte CHR_PHASE2[8] = { 0, 0, 134, 137, 140, 143, 146, 149 };
+
+// streamed formation tiles: each phase's run starts CHR_FLAP_FIRST
+// tiles after CHR_FLAP_ADDR (table 0, tile 128), and the data is in
+// CHR_FLAP0 (as uploaded) and CHR_FLAP1 from 16*CHR_FLAP_DATA
+#define CHR_FLAP_ADDR 0x0800
+#define CHR_FLAP_TILES 22
+const byte CHR_FLAP_FIRST[8] = { 0, 2, 4, 7, 10, 13, 16, 19 };
+const byte CHR_FLAP_COUNT[8] = { 2, 2, 3, 3, 3, 3, 3, 3 };
+const byte CHR_FLAP_DATA[8] = { 0, 2, 4, 7, 10, 13, 16, 19 };
+
+// wing-flap frame 0
+const byte CHR_FLAP0[352] = {
+  0x00,0x00,0x40,0xE0,0xB0,0x08,0x00,0x00,0x00,0x44,0xA4,0x17,0x0D,0x05,0x02,0x00,
+  0x00,0x00,0x04,0x0E,0x1A,0x20,0x00,0x00,0x00,0x44,0x4A,0xD0,0x60,0x40,0x80,0x00,
+  0x00,0x00,0x20,0x70,0x58,0x04,0x00,0x00,0x00,0x22,0x52,0x0B,0x06,0x02,0x01,0x00,
+  0x00,0x00,0x02,0x07,0x0D,0x10,0x00,0x00,0x00,0x22,0x25,0xE8,0xB0,0xA0,0x40,0x00,
+  0x00,0x00,0x10,0x38,0x2C,0x02,0x00,0x00,0x00,0x11,0x29,0x05,0x03,0x01,0x00,0x00,
+  0x00,0x00,0x01,0x03,0x06,0x08,0x00,0x00,0x00,0x11,0x12,0xF4,0x58,0x50,0xA0,0x00,
+  0x00,0x00,0x00,0x80,0x80,0x00,0x00,0x00,0x00,0x00,0x80,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x08,0x1C,0x16,0x01,0x00,0x00,0x00,0x08,0x14,0x02,0x01,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x01,0x03,0x04,0x00,0x00,0x00,0x88,0x89,0xFA,0xAC,0xA8,0x50,0x00,
+  0x00,0x00,0x80,0xC0,0x40,0x00,0x00,0x00,0x00,0x80,0x40,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x04,0x0E,0x0B,0x00,0x00,0x00,0x00,0x04,0x0A,0x01,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x01,0x82,0x00,0x00,0x00,0x44,0x44,0x7D,0xD6,0x54,0x28,0x00,
+  0x00,0x00,0x40,0xE0,0xA0,0x00,0x00,0x00,0x00,0x40,0xA0,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x02,0x07,0x05,0x00,0x00,0x00,0x00,0x02,0x05,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x80,0x41,0x00,0x00,0x00,0x22,0x22,0xBE,0x6B,0x2A,0x14,0x00,
+  0x00,0x00,0x20,0x70,0xD0,0x00,0x00,0x00,0x00,0x20,0x50,0x80,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x01,0x03,0x02,0x00,0x00,0x00,0x00,0x01,0x02,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x80,0xC0,0x20,0x00,0x00,0x00,0x11,0x91,0x5F,0x35,0x15,0x0A,0x00,
+  0x00,0x00,0x10,0x38,0x68,0x80,0x00,0x00,0x00,0x10,0x28,0x40,0x80,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x01,0x01,0x00,0x00,0x00,0x00,0x00,0x01,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x80,0xC0,0x60,0x10,0x00,0x00,0x00,0x88,0x48,0x2F,0x1A,0x0A,0x05,0x00,
+  0x00,0x00,0x08,0x1C,0x34,0x40,0x00,0x00,0x00,0x88,0x94,0xA0,0xC0,0x80,0x00,0x00,
+};
+
+// wing-flap frame 1
+const byte CHR_FLAP1[352] = {
+  0x00,0x18,0x38,0x38,0x28,0x00,0x00,0x00,0x18,0x24,0x44,0x47,0x45,0x45,0x02,0x00,
+  0x00,0x30,0x38,0x38,0x28,0x00,0x00,0x00,0x30,0x48,0x44,0xC4,0x44,0x44,0x80,0x00,
+  0x00,0x0C,0x1C,0x1C,0x14,0x00,0x00,0x00,0x0C,0x12,0x22,0x23,0x22,0x22,0x01,0x00,
+  0x00,0x18,0x1C,0x1C,0x14,0x00,0x00,0x00,0x18,0x24,0x22,0xE2,0xA2,0xA2,0x40,0x00,
+  0x00,0x06,0x0E,0x0E,0x0A,0x00,0x00,0x00,0x06,0x09,0x11,0x11,0x11,0x11,0x00,0x00,
+  0x00,0x0C,0x0E,0x0E,0x0A,0x00,0x00,0x00,0x0C,0x12,0x11,0xF1,0x51,0x51,0xA0,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x03,0x07,0x07,0x05,0x00,0x00,0x00,0x03,0x04,0x08,0x08,0x08,0x08,0x00,0x00,
+  0x00,0x06,0x07,0x07,0x05,0x00,0x00,0x00,0x06,0x89,0x88,0xF8,0xA8,0xA8,0x50,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x80,0x80,0x80,0x80,0x00,0x00,
+  0x00,0x01,0x03,0x03,0x02,0x00,0x00,0x00,0x01,0x02,0x04,0x04,0x04,0x04,0x00,0x00,
+  0x00,0x83,0x83,0x83,0x82,0x00,0x00,0x00,0x83,0x44,0x44,0x7C,0x54,0x54,0x28,0x00,
+  0x00,0x00,0x80,0x80,0x80,0x00,0x00,0x00,0x00,0x80,0x40,0x40,0x40,0x40,0x00,0x00,
+  0x00,0x00,0x01,0x01,0x01,0x00,0x00,0x00,0x00,0x01,0x02,0x02,0x02,0x02,0x00,0x00,
+  0x00,0xC1,0xC1,0xC1,0x41,0x00,0x00,0x00,0xC1,0x22,0x22,0x3E,0x2A,0x2A,0x14,0x00,
+  0x00,0x80,0xC0,0xC0,0x40,0x00,0x00,0x00,0x80,0x40,0x20,0x20,0x20,0x20,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x01,0x01,0x01,0x01,0x00,0x00,
+  0x00,0x60,0xE0,0xE0,0xA0,0x00,0x00,0x00,0x60,0x91,0x11,0x1F,0x15,0x15,0x0A,0x00,
+  0x00,0xC0,0xE0,0xE0,0xA0,0x00,0x00,0x00,0xC0,0x20,0x10,0x10,0x10,0x10,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x30,0x70,0x70,0x50,0x00,0x00,0x00,0x30,0x48,0x88,0x8F,0x8A,0x8A,0x05,0x00,
+  0x00,0x60,0x70,0x70,0x50,0x00,0x00,0x00,0x60,0x90,0x88,0x88,0x88,0x88,0x00,0x00,
+};
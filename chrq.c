@@ -0,0 +1,31 @@
+
+#include "neslib.h"
+#include "chrq.h"
+
+//#link "chrq.s"
+
+byte chrq_budget = CHRQ_BUDGET;
+
+// job ring, read by chrq_nmi() (chrq.s); the NMI moves
+// chrq_head and the jobs it has partly sent, we move chrq_tail
+byte chrq_addr_lo[CHRQ_JOBS];
+byte chrq_addr_hi[CHRQ_JOBS];
+byte chrq_src_lo[CHRQ_JOBS];
+byte chrq_src_hi[CHRQ_JOBS];
+byte chrq_tiles[CHRQ_JOBS];	// tiles left to send
+volatile byte chrq_head;
+volatile byte chrq_tail;
+
+byte chrq_put(word addr, const byte* src, byte tiles) {
+  register byte t = chrq_tail;
+  byte next = (t + 1) & (CHRQ_JOBS-1);
+  if (next == chrq_head)
+    return 0;
+  chrq_addr_lo[t] = addr;
+  chrq_addr_hi[t] = addr >> 8;
+  chrq_src_lo[t] = (word)src;
+  chrq_src_hi[t] = (word)src >> 8;
+  chrq_tiles[t] = tiles;
+  chrq_tail = next; // the NMI can have it now
+  return 1;
+}
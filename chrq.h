@@ -0,0 +1,34 @@
+
+#ifndef _CHRQ_H
+#define _CHRQ_H
+
+#include "neslib.h"
+
+// CHR RAM upload queue, drained in vblank by chrq_nmi() after
+// the VRAM buffer, with a byte budget of its own. Uploads are
+// whole tiles; a job that fits in one vblank's budget is never
+// split across two, so the tiles it changes flip together.
+
+// queued jobs (a power of 2; one slot stays empty)
+#define CHRQ_JOBS 16
+
+// default bytes per vblank (a multiple of 16, at least 16);
+// a tile costs 184 cycles of vblank
+#define CHRQ_BUDGET 48
+
+extern byte chrq_budget;
+
+// queue tiles (1-15) from src to CHR RAM at addr; src must
+// stay put until sent. Returns 0 if the queue is full.
+byte chrq_put(word addr, const byte* src, byte tiles);
+
+// nonzero while uploads are waiting
+#define chrq_busy() (chrq_head != chrq_tail)
+
+extern volatile byte chrq_head;	// next job for the NMI
+extern volatile byte chrq_tail;	// next free slot
+
+// NMI: send what this vblank's budget allows
+void __fastcall__ chrq_nmi(void);
+
+#endif // chrq.h
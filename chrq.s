@@ -0,0 +1,128 @@
+;
+; CHR RAM upload queue, drained once per frame from the NMI.
+; See chrq.h; the job ring is in chrq.c.
+;
+; Copies are unrolled a tile at a time: 184 cycles a tile,
+; plus ~190 a call (measured on a 6502 model, JSR/RTS
+; included), so a 3-tile job takes 740. A job that doesn't
+; fit in what's left of the budget waits for the next vblank,
+; unless it's bigger than a whole budget.
+;
+
+.export _chrq_nmi
+.import _chrq_budget, _chrq_head, _chrq_tail
+.import _chrq_addr_lo, _chrq_addr_hi, _chrq_src_lo, _chrq_src_hi
+.import _chrq_tiles
+.import _get_ppu_ctrl_var
+
+PPU_CTRL	= $2000
+PPU_STATUS	= $2002
+PPU_SCROLL	= $2005
+PPU_ADDR	= $2006
+PPU_DATA	= $2007
+
+CHRQ_JOBS	= 16		; must match chrq.h
+
+.segment "ZEROPAGE"
+
+src:	.res 2
+
+.segment "BSS"
+
+full:	.res 1			; budget in tiles
+left:	.res 1			; tiles left this vblank
+sent:	.res 1			; tiles sent from this job
+count:	.res 1
+
+.segment "CODE"
+
+; void __fastcall__ chrq_nmi(void);
+_chrq_nmi:
+	ldx _chrq_head
+	cpx _chrq_tail
+	bne @start
+	rts
+@done:
+	; our writes moved the PPU address: restore the scroll
+	lda #0
+	sta PPU_SCROLL
+	sta PPU_SCROLL
+	jsr _get_ppu_ctrl_var
+	sta PPU_CTRL
+	rts
+@start:
+	lda _chrq_budget
+	lsr
+	lsr
+	lsr
+	lsr
+	sta full
+	sta left
+	beq @done		; budget under a tile
+@job:
+	lda _chrq_tiles,x
+	cmp left
+	bcc @fits
+	beq @fits
+	; too big for what's left: wait, unless it can never fit
+	lda left
+	cmp full
+	bne @done
+@fits:
+	sta sent
+	sta count
+	bit PPU_STATUS
+	lda _chrq_addr_hi,x
+	sta PPU_ADDR
+	lda _chrq_addr_lo,x
+	sta PPU_ADDR
+	lda _chrq_src_lo,x
+	sta src
+	lda _chrq_src_hi,x
+	sta src+1
+	ldy #0
+@tile:
+.repeat 16
+	lda (src),y
+	sta PPU_DATA
+	iny
+.endrepeat
+	dec count
+	bne @tile
+	; Y = bytes sent (at most 240)
+	lda left
+	sec
+	sbc sent
+	sta left
+	lda _chrq_tiles,x
+	sec
+	sbc sent
+	sta _chrq_tiles,x
+	bne @partial
+	; done with this job: next one, if the budget allows
+	inx
+	txa
+	and #CHRQ_JOBS-1
+	tax
+	stx _chrq_head
+	lda left
+	beq @finish
+	cpx _chrq_tail
+	beq @finish
+	jmp @job
+@partial:
+	; sent as much as the budget allows: move the job on
+	tya
+	clc
+	adc _chrq_addr_lo,x
+	sta _chrq_addr_lo,x
+	bcc :+
+	inc _chrq_addr_hi,x
+:	tya
+	clc
+	adc _chrq_src_lo,x
+	sta _chrq_src_lo,x
+	bcc @finish
+	inc _chrq_src_hi,x
+@finish:
+	jmp @done
@@ -0,0 +1,30 @@
+
+#ifndef _HOTZP_H
+#define _HOTZP_H
+
+#include "neslib.h"
+
+// hot game state, placed in zero page by hotzp.s
+// (HOTZP segment in shoot2.cfg)
+
+extern byte player_x;
+#pragma zpsym ("player_x")
+extern byte player_exploding;
+#pragma zpsym ("player_exploding")
+extern byte enemy_exploding;
+#pragma zpsym ("enemy_exploding")
+extern byte enemies_left;
+#pragma zpsym ("enemies_left")
+
+extern byte formation_offset_x;
+#pragma zpsym ("formation_offset_x")
+extern signed char formation_direction;
+#pragma zpsym ("formation_direction")
+extern byte current_row;
+#pragma zpsym ("current_row")
+
+// pool object that gets the first OAM slot
+extern byte oam_rotate;
+#pragma zpsym ("oam_rotate")
+
+#endif // hotzp.h
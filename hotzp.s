@@ -0,0 +1,33 @@
+;
+; Hot state in zero page, so cc65 can use zp addressing
+; (and (zp),y for updbuf). Declared to C with #pragma zpsym
+; in hotzp.h and vrambuf.h. Zero page can't hold initialized
+; data: the startup code clears it, anything nonzero must be
+; set at runtime.
+;
+; shoot2.cfg places HOTZP after the cc65 runtime and neslib
+; zero page; run tools/zpreport.py on the map file to see
+; how much is left.
+;
+
+.segment "HOTZP": zeropage
+
+; shoot2.c
+.exportzp _player_x, _player_exploding, _enemy_exploding, _enemies_left
+.exportzp _formation_offset_x, _formation_direction, _current_row
+.exportzp _oam_rotate
+
+_player_x:		.res 1
+_player_exploding:	.res 1
+_enemy_exploding:	.res 1
+_enemies_left:		.res 1
+_formation_offset_x:	.res 1
+_formation_direction:	.res 1
+_current_row:		.res 1
+_oam_rotate:		.res 1
+
+; vrambuf.c
+.exportzp _updbuf, _updptr
+
+_updbuf:		.res 2
+_updptr:		.res 1
@@ -0,0 +1,47 @@
+;
+; MMC3 reset and interrupt entry for FORMATION_IRQ builds
+; (shoot2_mmc3.cfg). Only $E000-$FFFF is mapped at power-on,
+; so the vectors point here, in that bank. Reset maps PRG
+; banks 0-3 in order at $8000-$FFFF before anything else
+; runs, then enters the runtime's startup code. NMI and IRQ
+; go through the runtime's own vectors, which the config
+; puts at CRTVEC; that costs them 5 cycles.
+;
+
+.import __CRTVEC_START__
+
+MMC3_SELECT	= $8000
+MMC3_BANK	= $8001
+MMC3_IRQ_OFF	= $e000
+
+CRT_NMI		= __CRTVEC_START__
+CRT_RESET	= __CRTVEC_START__+2
+CRT_IRQ		= __CRTVEC_START__+4
+
+.segment "MMC3INIT"
+
+reset:
+	sei
+	cld
+	; PRG mode 0: R6 at $8000, R7 at $A000, then the
+	; last two banks fixed at $C000 and $E000
+	lda #6
+	sta MMC3_SELECT
+	lda #0
+	sta MMC3_BANK
+	lda #7
+	sta MMC3_SELECT
+	lda #1
+	sta MMC3_BANK
+	sta MMC3_IRQ_OFF
+	jmp (CRT_RESET)
+
+nmi:
+	jmp (CRT_NMI)
+
+irq:
+	jmp (CRT_IRQ)
+
+.segment "MMC3VECTORS"
+
+	.word nmi, reset, irq
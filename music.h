@@ -0,0 +1,15 @@
+
+#ifndef _MUSIC_H
+#define _MUSIC_H
+
+#include "neslib.h"
+
+// Background music (music.s): a FamiTone2 song, started with
+// neslib's music_play() and run by famitone_update() in the
+// NMI. Off unless MUSIC is 1 in music.s, with the player and
+// song in the project; the calls do nothing until then.
+
+// load the song, for PAL or NTSC timing
+void music_init(void);
+
+#endif // music.h
@@ -0,0 +1,92 @@
+;
+; Background music: FamiTone2 with our settings, one song, and
+; the C calls (music.h, neslib.h). Off unless MUSIC is 1; the
+; calls then do nothing and neither file below is needed.
+;
+; famitone2.s is FamiTone2 1.15 as released, with its settings
+; block still commented out; it is assembled here, so these
+; settings are the only ones. The song is
+; music_dangerstreets.s from the 8bitworkshop NES presets.
+;
+; Variables and scratch bytes go where shoot2.cfg (and
+; shoot2_mmc3.cfg) reserve them, FTRAM and FTZP; the link
+; fails if they move apart. Without DPCM or FamiTone's own
+; effects the variables take 123 bytes, and FamiTone never
+; writes $4015. snd.s reads FamiTone's record of the pulse
+; period high bytes (ft_pulse_prev) to see when the music
+; wrote them.
+;
+
+MUSIC		= 0		; 1 with both files in the project
+
+.export _music_init, _famitone_update
+.export _music_play, _music_stop, _music_pause
+.export ft_pulse_prev
+
+.if MUSIC
+
+.import _ppu_system
+.import __FTRAM_START__, __FTRAM_SIZE__, __FTZP_START__
+
+FT_BASE_ADR	= $0300		; FTRAM
+FT_TEMP		= $fd		; FTZP, 3 bytes
+FT_DPCM_OFF	= $c000		; unused
+FT_SFX_STREAMS	= 1		; unused
+
+.define FT_DPCM_ENABLE	0
+.define FT_SFX_ENABLE	0
+.define FT_THREAD	1
+.define FT_PAL_SUPPORT	1
+.define FT_NTSC_SUPPORT	1
+
+.segment "CODE"
+
+.include "famitone2.s"
+.include "music_dangerstreets.s"
+
+.assert FT_BASE_ADR = __FTRAM_START__, lderror, "FT_BASE_ADR is not FTRAM"
+.assert FT_SFX_ADR_L <= __FTRAM_START__ + __FTRAM_SIZE__, lderror, "FTRAM is too small"
+.assert FT_TEMP = __FTZP_START__, lderror, "FT_TEMP is not FTZP"
+
+; pulse 1, then pulse 2: the last high period byte written
+.assert FT_PULSE2_PREV = FT_PULSE1_PREV + 1, error, "FT_PULSE*_PREV moved"
+ft_pulse_prev	= FT_PULSE1_PREV
+
+.segment "CODE"
+
+; void music_init(void);
+_music_init:
+	jsr _ppu_system		; 0 on PAL
+	ldx #<_danger_streets_music_data
+	ldy #>_danger_streets_music_data
+	jmp FamiToneInit
+
+; void __fastcall__ music_play(unsigned char song);
+_music_play	= FamiToneMusicPlay
+
+; void __fastcall__ music_stop(void);
+_music_stop	= FamiToneMusicStop
+
+; void __fastcall__ music_pause(unsigned char pause);
+_music_pause	= FamiToneMusicPause
+
+; void __fastcall__ famitone_update(void);
+_famitone_update = FamiToneUpdate
+
+.else
+
+.segment "BSS"
+
+; nothing else writes the pulse high periods
+ft_pulse_prev:	.res 2
+
+.segment "CODE"
+
+_music_init:
+_music_play:
+_music_stop:
+_music_pause:
+_famitone_update:
+	rts
+
+.endif
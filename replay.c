@@ -0,0 +1,75 @@
+
+#include "neslib.h"
+#include "replay.h"
+
+byte replay_mode;
+
+static byte* log_ptr;	// current run (record) or next run (play)
+static byte* log_end;	// recording stops here
+static byte run;	// frames in (record) or left in (play) this run
+static byte run_pad;	// pad value of this run
+
+void replay_live(word seed) {
+  set_rand(seed);
+  replay_mode = REPLAY_LIVE;
+}
+
+void replay_record(word seed, byte* buf, word size) {
+  set_rand(seed);
+  buf[0] = seed;
+  buf[1] = seed >> 8;
+  log_ptr = buf + 2;
+  log_ptr[0] = 0; // empty log
+  // a run and the end marker after it must fit
+  log_end = buf + size - 2;
+  run = 0;
+  replay_mode = REPLAY_RECORD;
+}
+
+void replay_play(const byte* log) {
+  set_rand(log[0] | (log[1] << 8));
+  log_ptr = (byte*)log + 2;
+  run = 0;
+  replay_mode = REPLAY_PLAY;
+}
+
+static byte record_pad(void) {
+  byte pad = pad_poll(0);
+  // start a new run?
+  if (run == 0 || pad != run_pad || run == 255) {
+    if (run) log_ptr += 2;
+    if (log_ptr >= log_end) {
+      // full, the log already ends here
+      replay_mode = REPLAY_LIVE;
+      return pad;
+    }
+    log_ptr[1] = run_pad = pad;
+    log_ptr[2] = 0; // end marker
+    run = 0;
+  }
+  log_ptr[0] = ++run;
+  return pad;
+}
+
+static byte play_pad(void) {
+  if (run == 0) {
+    run = log_ptr[0];
+    if (run == 0) {
+      // end of log
+      replay_mode = REPLAY_LIVE;
+      return pad_poll(0);
+    }
+    run_pad = log_ptr[1];
+    log_ptr += 2;
+  }
+  --run;
+  return run_pad;
+}
+
+byte replay_pad(void) {
+  switch (replay_mode) {
+    case REPLAY_RECORD: return record_pad();
+    case REPLAY_PLAY: return play_pad();
+    default: return pad_poll(0);
+  }
+}
@@ -0,0 +1,37 @@
+
+#ifndef _REPLAY_H
+#define _REPLAY_H
+
+#include "neslib.h"
+
+// Seeded random numbers and pad 0 input that can be recorded
+// and played back, so the same log gives the same game.
+//
+// Log format: the seed (2 bytes, low first), then runs of
+// (frames, pad) pairs, frames 1-255; a frame count of 0 ends
+// the log.
+
+#define REPLAY_LIVE	0	// read the pad
+#define REPLAY_RECORD	1	// read the pad and log it
+#define REPLAY_PLAY	2	// read input from a log
+
+extern byte replay_mode;
+
+// the RNG is neslib's rand8(), two 8-bit LFSRs; neither
+// byte of the seed may be zero
+#define REPLAY_SEED 0x5a3c
+
+// read the pad, starting the RNG from seed
+void replay_live(word seed);
+
+// read the pad and log it into buf (size bytes, at least 5);
+// when buf is full, recording stops and the log is kept
+void replay_record(word seed, byte* buf, word size);
+
+// play a log; at its end, the pad is read again
+void replay_play(const byte* log);
+
+// pad 0 for this frame (call once per frame)
+byte replay_pad(void);
+
+#endif // replay.h
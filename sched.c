@@ -0,0 +1,25 @@
+
+#include "neslib.h"
+#include "sched.h"
+
+byte sched_budget = SCHED_BUDGET;
+byte sched_frame;
+byte sched_spent;
+word sched_skipped;
+
+void sched_run(register const SchedTask* task, byte count, byte frame) {
+  sched_frame = frame;
+  sched_spent = 0;
+  while (count--) {
+    if ((frame & (task->period-1)) == task->phase) {
+      if (task->optional &&
+          sched_spent + task->cost > sched_budget) {
+        ++sched_skipped;
+      } else {
+        sched_spent += task->cost;
+        task->run();
+      }
+    }
+    ++task;
+  }
+}
@@ -0,0 +1,48 @@
+
+#ifndef _SCHED_H
+#define _SCHED_H
+
+#include "neslib.h"
+
+// Time-sliced frame scheduler. Each task runs when
+// (frame & (period-1)) == phase, so work can be spread over
+// frames instead of landing on one.
+//
+// Costs are estimates in 64ths of a frame (465 cycles, as in
+// telemetry.h); nesprof's incl/frame column divided by 465
+// gives them. Optional tasks are skipped for the period when
+// running them would take the frame over sched_budget.
+// Estimates rather than measured time keep the schedule, and
+// so a replay, the same on every run.
+
+typedef struct {
+  void (*run)(void);
+  byte period;		// frames, a power of 2
+  byte phase;		// 0..period-1
+  byte cost;		// estimate, 64ths of a frame
+  byte optional;	// may be skipped when over budget
+} SchedTask;
+
+// default budget for the tasks; the rest of the frame is the
+// NMI (VRAM, music, effects) and the work outside the tasks.
+// With ROUND_TASKS, a star frame costs 20 plus 4 per formation
+// row redrawn: one row ripples every frame, so the stars drop
+// out when a kill makes it two (28 + 1)
+#define SCHED_BUDGET 28
+
+extern byte sched_budget;
+
+// frame being run (for tasks that pick an entity by frame)
+extern byte sched_frame;
+
+// estimated cost so far this frame; tasks with variable
+// work add its cost here as they go
+extern byte sched_spent;
+
+// optional task runs skipped (wraps around)
+extern word sched_skipped;
+
+// run the tasks due this frame, in table order
+void sched_run(const SchedTask* tasks, byte count, byte frame);
+
+#endif // sched.h
@@ -0,0 +1,92 @@
+
+#include "neslib.h"
+#include "vrambuf.h"
+#include "screen.h"
+#include <string.h>
+
+// streaming decoder state
+static const byte* src;	// next packed byte
+static byte tag;	// RLE tag byte of this screen
+static byte last;	// byte to repeat
+static byte run;	// repeats left
+static word dest;	// next VRAM address
+static word left;	// bytes left to send
+
+// unpack a screen at addr right away (rendering must be off)
+void screen_blast(const Screen* scr, word addr) {
+  vram_adr(addr);
+  vram_unrle(scr->rle);
+}
+
+// start streaming a screen to addr through the VRAM buffer
+void screen_stream(const Screen* scr, word addr) {
+  src = scr->rle;
+  tag = *src++;
+  run = 0;
+  dest = addr;
+  left = 1024;
+}
+
+// decode the next n bytes into buf (same rules as vram_unrle)
+static void decode(register byte* buf, byte n) {
+  register byte b;
+  while (n) {
+    if (run) {
+      --run;
+    } else if ((b = *src++) != tag) {
+      last = b;
+    } else {
+      run = *src++ - 1;
+      if (run == 0xff) break; // end tag, shouldn't happen
+    }
+    *buf++ = last;
+    --n;
+  }
+}
+
+// queue as many chunks as the vblank budget allows;
+// returns nonzero while there is more to send
+byte screen_stream_step(void) {
+  static byte buf[SCREEN_CHUNK];
+  // always send one chunk so a small budget still makes progress
+  do {
+    if (left == 0) break;
+    decode(buf, SCREEN_CHUNK);
+    vrambuf_put(dest, buf, SCREEN_CHUNK);
+    dest += SCREEN_CHUNK;
+    left -= SCREEN_CHUNK;
+  } while (VRAMBUF_FITS(SCREEN_CHUNK));
+  return left != 0;
+}
+
+// stream a whole screen, flushing frames until it's done
+// (nothing else is drawing, so take two chunks per frame)
+void screen_show(const Screen* scr, word addr) {
+  byte budget = vrambuf_budget;
+  byte more;
+  vrambuf_budget = SCREEN_SHOW_BUDGET;
+  screen_stream(scr, addr);
+  do {
+    more = screen_stream_step();
+    vrambuf_flush();
+  } while (more);
+  vrambuf_budget = budget;
+}
+
+// fill the names at addr with tile and the attributes with attr,
+// as VRAM buffer fills, flushing frames until it's done
+void screen_fill(word addr, byte tile, byte attr) {
+  byte budget = vrambuf_budget;
+  word end = addr + 960;
+  if (addr == NAMETABLE_A)
+    memset(vrambuf_attr, attr, sizeof(vrambuf_attr));
+  vrambuf_budget = SCREEN_SHOW_BUDGET;
+  for (; addr != end; addr += SCREEN_FILL) {
+    if (!VRAMBUF_FITS_FILL(SCREEN_FILL)) vrambuf_flush();
+    vrambuf_fill(addr, tile, SCREEN_FILL);
+  }
+  if (!VRAMBUF_FITS_FILL(64)) vrambuf_flush();
+  vrambuf_fill(addr, attr, 64);
+  vrambuf_flush();
+  vrambuf_budget = budget;
+}
@@ -0,0 +1,42 @@
+
+#ifndef _SCREEN_H
+#define _SCREEN_H
+
+#include "neslib.h"
+
+// bytes per streamed chunk (one nametable row)
+#define SCREEN_CHUNK 32
+
+// vblank budget while screen_show() runs (two chunks)
+#define SCREEN_SHOW_BUDGET (2*(SCREEN_CHUNK+3))
+
+// bytes per fill in screen_fill() (four rows, one per
+// frame at SCREEN_SHOW_BUDGET)
+#define SCREEN_FILL 120
+
+// a full nametable (names + attributes), made by tools/mkscreen.py
+typedef struct {
+  const byte* rle;	// 1024 bytes, vram_unrle() format
+  word size;		// packed bytes in ROM
+  word blast_cycles;	// CPU cycles for screen_blast()
+  byte frames;		// vblanks for screen_stream() at SCREEN_CHUNK
+} Screen;
+
+// unpack a screen at addr right away (rendering must be off)
+void screen_blast(const Screen* scr, word addr);
+
+// start streaming a screen to addr through the VRAM buffer
+void screen_stream(const Screen* scr, word addr);
+
+// queue as many chunks as the vblank budget allows;
+// returns nonzero while there is more to send
+byte screen_stream_step(void);
+
+// stream a whole screen, flushing frames until it's done
+void screen_show(const Screen* scr, word addr);
+
+// fill the names at addr with tile and the attributes with attr,
+// flushing frames until it's done (9 vblanks, 4 buffer bytes each)
+void screen_fill(word addr, byte tile, byte attr);
+
+#endif // screen.h
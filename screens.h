@@ -0,0 +1,11 @@
+
+// generated by tools/mkscreen.py, do not edit
+
+#include "screen.h"
+
+// fill:0, 1024 bytes
+const byte SCREEN_CLEAR_RLE[14] = {
+  0x01,0x00,0x01,0xFF,0x01,0xFF,0x01,0xFF,0x01,0xFF,0x01,0x03,0x01,0x00,
+};
+
+const Screen SCREEN_CLEAR = { SCREEN_CLEAR_RLE, 14, 9422, 32 };
@@ -12,25 +12,75 @@ Sprites are used for the player, missiles, attackers, and stars.
 
 #include "neslib.h"
 
+// shoot2_mmc3.c builds this file for MMC3, with its own
+// mapper, config and links (see README)
+#ifndef FORMATION_IRQ
 #define NES_MAPPER 2	// mapper 2 (UxROM mapper)
 #define NES_CHR_BANKS 0	// CHR RAM
+#endif
 
 // APU (sound) support
 #include "apu.h"
 //#link "apu.c"
 
+// sound effects, sequenced in the NMI
+#include "snd.h"
+//#link "snd.c"
+
+// music: FamiTone2 player and song, off by default
+// (MUSIC in music.s), updated in the NMI (see README)
+#include "music.h"
+//#link "music.s"
+
+// seeded RNG and input record/replay
+#include "replay.h"
+//#link "replay.c"
+
 // BCD arithmetic support
 #include "bcd.h"
-//#link "bcd.c"
+//#link "bcd.s"
 
 // VRAM update buffer
 #include "vrambuf.h"
 //#link "vrambuf.c"
 
+// CHR RAM upload queue, drained in the NMI
+#include "chrq.h"
+//#link "chrq.c"
+
+// full-screen layouts
+#include "screen.h"
+//#link "screen.c"
+#include "screens.h"
+
+// frame task scheduler
+#include "sched.h"
+//#link "sched.c"
+
+// raster meter, lag counter and frame cost log
+#include "telemetry.h"
+//#link "telemetry.c"
+
+#ifdef FORMATION_IRQ
+// formation rows scrolled by IRQ splits
+#include "band.h"
+#endif
+
+// hot state in zero page
+#include "hotzp.h"
+//#link "hotzp.s"
+
+// linker config with the HOTZP segment
+#ifndef FORMATION_IRQ
+//#resource "shoot2.cfg"
+#define CFGFILE shoot2.cfg
+#endif
+
 #define COLS 32
 #define ROWS 28
 
-//#define DEBUG_FRAMERATE
+//#define DEBUG_TELEMETRY
+//#define DEBUG_OAM_DENSITY
 
 /*{pal:"nes",layout:"nes"}*/
 const char PALETTE[32] = { 
@@ -55,133 +105,14 @@ const char PALETTE[32] = {
 #define COLOR_SCORE		2
 #define COLOR_EXPLOSION		3
 
-/*{w:8,h:8,bpp:1,count:128,brev:1,np:2,pofs:8,remap:[0,1,2,4,5,6,7,8,9,10,11,12]}*/
-const char TILESET[128*8*2] = {
-// font (0..63)
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x38,0x7C,0x7C,0x7C,0x38,0x00,0x38,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x6C,0x6C,0x48,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x6C,0xFE,0x6C,0xFE,0x6C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x10,0xFE,0xD0,0xFE,0x16,0xFE,0x10,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xCE,0xDC,0x38,0x76,0xE6,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x38,0x6C,0x7C,0xEC,0xEE,0x7E,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x38,0x38,0x30,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x38,0x70,0x70,0x70,0x70,0x70,0x38,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x70,0x38,0x38,0x38,0x38,0x38,0x30,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x6C,0x38,0x6C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x38,0x38,0xFE,0x38,0x38,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x30,0x30,0x60,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x60,0x60,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x0E,0x1E,0x3C,0x78,0xF0,0xE0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x7C,0xEE,0xEE,0xEE,0xEE,0x7C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x38,0x78,0x38,0x38,0x38,0x7C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7C,0x0E,0x7C,0xE0,0xEE,0xFE,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC,0x0E,0x3C,0x0E,0x0E,0xFC,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x3E,0x7E,0xEE,0xEE,0xFE,0x0E,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC,0xE0,0xFC,0x0E,0xEE,0x7C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7C,0xE0,0xFC,0xEE,0xEE,0x7C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFE,0xEE,0x1C,0x1C,0x38,0x38,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7C,0xEE,0x7C,0xEE,0xEE,0x7C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7C,0xEE,0xEE,0x7E,0x0E,0x3C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x60,0x60,0x00,0x00,0x60,0x60,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x60,0x60,0x00,0x00,0x60,0x60,0xC0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x1C,0x38,0x70,0x70,0x38,0x1C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7C,0x00,0x00,0x7C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x70,0x38,0x1C,0x1C,0x38,0x70,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7C,0xEE,0x1C,0x38,0x00,0x38,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x7C,0xEE,0xEE,0xEE,0xE0,0x7C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7C,0xEE,0xEE,0xEE,0xFE,0xEE,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC,0xEE,0xFC,0xEE,0xEE,0xFC,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7C,0xEE,0xE0,0xE0,0xEE,0x7C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xF8,0xEC,0xEE,0xEE,0xEE,0xFC,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFE,0xE0,0xF0,0xE0,0xE0,0xFE,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFE,0xE0,0xF8,0xE0,0xE0,0xE0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7C,0xE0,0xEE,0xEE,0xEE,0x7E,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xEE,0xEE,0xFE,0xEE,0xEE,0xEE,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7C,0x38,0x38,0x38,0x38,0x7C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x0E,0x0E,0x0E,0x0E,0xEE,0x7C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xEE,0xFC,0xF8,0xEC,0xEE,0xEE,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xE0,0xE0,0xE0,0xE0,0xEE,0xFE,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xC6,0xEE,0xFE,0xFE,0xEE,0xEE,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xCE,0xEE,0xFE,0xFE,0xEE,0xE6,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7C,0xEE,0xEE,0xEE,0xEE,0x7C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0xFC,0xEE,0xEE,0xEE,0xFC,0xE0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7C,0xEE,0xEE,0xEE,0xEC,0x7E,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC,0xEE,0xEE,0xEE,0xFC,0xEE,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7C,0xE0,0x7C,0x0E,0xEE,0x7C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFE,0x38,0x38,0x38,0x38,0x38,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xEE,0xEE,0xEE,0xEE,0xEE,0x7C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xEE,0xEE,0xEE,0x6C,0x38,0x10,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xEE,0xEE,0xFE,0xFE,0xEE,0xC6,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xEE,0x7C,0x38,0x7C,0xEE,0xEE,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xEE,0xEE,0xEE,0x7C,0x38,0x38,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFE,0x1C,0x38,0x70,0xE0,0xFE,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x6C,0x92,0x82,0x82,0x44,0x28,0x10,0x00,0x6C,0xFE,0xFE,0xFE,0x7C,0x38,0x10,0x00,0x6C,0x92,0x82,0x82,0x44,0x28,0x10,0x00,0x6C,0x92,0x82,0x82,0x44,0x28,0x10,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-/*{w:16,h:16,bpp:1,count:16,brev:1,np:2,pofs:8,remap:[5,0,1,2,4,6,7,8,9,10,11,12]}*/  
-// formation enemy (64,66)
-0x00,0x00,0x40,0xE0,0xB0,0x08,0x00,0x00,0x00,0x44,0xA4,0x17,0x0D,0x05,0x02,0x00,
-0x00,0x18,0x38,0x38,0x28,0x00,0x00,0x00,0x18,0x24,0x44,0x47,0x45,0x45,0x02,0x00,
-0x00,0x00,0x04,0x0E,0x1A,0x20,0x00,0x00,0x00,0x44,0x4A,0xD0,0x60,0x40,0x80,0x00,
-0x00,0x30,0x38,0x38,0x28,0x00,0x00,0x00,0x30,0x48,0x44,0xC4,0x44,0x44,0x80,0x00,
-// attackers (68)
-0x00,0x00,0x00,0x00,0x00,0x04,0x4C,0x78,0x00,0x00,0x00,0x01,0x02,0x02,0x03,0x06,
-0x30,0x20,0x00,0x00,0x00,0x00,0x00,0x00,0x4A,0x50,0x20,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x10,0x19,0x0F,0x00,0x00,0x00,0x40,0xA0,0xA0,0xE0,0x30,
-0x06,0x02,0x00,0x00,0x00,0x00,0x00,0x00,0x29,0x05,0x02,0x00,0x00,0x00,0x00,0x00,
-
-0x00,0x00,0x00,0x40,0xE4,0x7C,0x70,0x00,0x00,0x00,0x00,0x01,0x02,0x82,0x8F,0x72,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x02,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x10,0x19,0x0F,0x00,0x00,0x00,0x40,0xA0,0xA0,0xE0,0x30,
-0x06,0x02,0x00,0x00,0x00,0x00,0x00,0x00,0x29,0x05,0x02,0x00,0x00,0x00,0x00,0x00,
-
-0x00,0x00,0x60,0x30,0x3C,0x00,0x00,0x00,0x00,0x00,0x00,0x41,0x42,0x3E,0x03,0x02,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x02,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x10,0x1C,0x0E,0x00,0x00,0x00,0x40,0xA0,0xA0,0xE0,0x30,
-0x06,0x03,0x03,0x00,0x00,0x00,0x00,0x00,0x28,0x04,0x04,0x03,0x00,0x00,0x00,0x00,
-  
-0x00,0x60,0x78,0x0C,0x04,0x00,0x00,0x00,0x00,0x00,0x00,0x71,0x0A,0x06,0x03,0x02,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x02,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x10,0x09,0x07,0x00,0x00,0x00,0x40,0xA0,0xA0,0xF0,0x28,
-0x07,0x02,0x00,0x00,0x00,0x00,0x00,0x00,0x28,0x05,0x02,0x00,0x00,0x00,0x00,0x00,
-
-0x00,0x31,0x58,0x0C,0x04,0x00,0x00,0x00,0x00,0x00,0x20,0x51,0x0A,0x06,0x03,0x02,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x02,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x55,0x00,0x00,0x00,0x19,0x0F,0x06,0x00,0x00,0x00,0x40,0xA0,0xA0,0xF0,0x29,
-0x02,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x25,0x02,0x00,0x00,0x00,0x00,0x00,0x00,
-  
-0x00,0x80,0xC0,0x60,0x3C,0x00,0x00,0x00,0x00,0x00,0x00,0x81,0x42,0x3E,0x03,0x02,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x02,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x01,0x01,0x03,0x06,0x1E,0x0C,0x00,0x00,0x00,0x00,0x40,0xA1,0xA1,0xF2,0x2C,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x20,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  
-0x00,0x00,0x00,0x00,0x04,0x58,0x70,0x20,0x00,0x00,0x00,0x01,0x02,0x06,0x0B,0x52,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x22,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x10,0x0D,0x07,0x02,0x00,0x00,0x00,0x40,0xA0,0xB0,0xE8,0x25,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x22,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-
-0x00,0x00,0x00,0x00,0x10,0x10,0x03,0x07,0x00,0x00,0x00,0x00,0x03,0x0F,0x1F,0x1F,
-0x24,0x40,0x00,0x00,0x07,0x63,0x41,0x00,0x3F,0x7F,0x7F,0x7F,0x78,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x08,0x08,0xC0,0xE0,0x00,0x00,0x00,0x00,0xC0,0xF0,0xF8,0xF8,
-0x24,0x02,0x00,0x00,0xE0,0xC6,0x82,0x00,0xFC,0xFE,0xFE,0xFE,0x1E,0x00,0x00,0x00,
-// player ship (96)
-0x10,0x08,0x00,0x10,0x08,0x5A,0x3C,0x5A,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x3C,0x24,0x18,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x38,0x38,0x38,0x00,0x00,0x00,0x00,0x00,0x10,0x38,0x10,0x00,0x00,0x04,
-0x00,0x00,0x80,0x10,0x38,0x10,0x00,0x00,0x00,0x00,0x00,0x00,0x10,0x00,0x00,0x20,
-// bullet (100)
-0x00,0x00,0x00,0x00,0x00,0x04,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-// stars (102)
-0x00,0x00,0x00,0x08,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x08,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x10,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-// explosions (112)
-0x00,0x00,0x00,0x08,0x04,0x03,0x06,0x05,0x00,0x00,0x00,0x04,0x02,0x04,0x00,0x18,
-0x05,0x06,0x07,0x00,0x00,0x00,0x00,0x00,0x18,0x00,0x08,0x09,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x08,0x90,0xE0,0x90,0xD0,0x00,0x00,0x00,0x10,0x20,0x10,0x00,0x0C,
-0xF0,0x20,0xE0,0x80,0x00,0x00,0x00,0x00,0x0C,0x10,0x18,0x48,0x00,0x00,0x00,0x00,
-
-0x00,0x04,0x12,0x0C,0x42,0x30,0x00,0x19,0x00,0x00,0x00,0x02,0x00,0x06,0x08,0x00,
-0x11,0x04,0x0C,0x00,0x21,0x46,0x00,0x00,0x04,0x10,0x02,0x0C,0x00,0x00,0x00,0x00,
-0x00,0x40,0x08,0x91,0xA2,0x04,0x80,0xCC,0x00,0x00,0x00,0x20,0x00,0x30,0x08,0x00,
-0xC4,0x10,0x1A,0x80,0x20,0x10,0x00,0x00,0x10,0x04,0xA0,0x18,0x80,0x00,0x00,0x00,
- 
-0x61,0x20,0x00,0x04,0x00,0xC4,0x08,0x10,0x00,0x00,0x04,0x02,0x09,0x02,0x10,0x04,
-0x10,0x00,0x42,0xC8,0x80,0x00,0x10,0x30,0x24,0x10,0x11,0x02,0x00,0x00,0x00,0x00,
-0x86,0xC4,0x00,0x10,0x01,0x10,0x08,0x04,0x00,0x00,0x10,0x20,0x48,0x20,0x04,0x10,
-0x04,0x00,0x20,0x89,0x00,0x84,0xC6,0x43,0x12,0x04,0x44,0x20,0x00,0x00,0x00,0x00,
-  
-0x00,0x00,0x02,0x08,0x00,0x06,0x02,0x00,0x00,0x40,0x08,0x01,0x11,0x11,0x00,0x38,
-0x30,0x02,0x00,0x00,0x00,0x00,0x00,0x00,0x08,0x00,0x10,0x00,0x04,0x40,0x00,0x00,
-0x00,0x00,0x20,0x08,0x00,0x30,0x20,0x00,0x02,0x00,0x08,0x40,0x44,0x44,0x00,0x0E,
-0x06,0x20,0x80,0x80,0x00,0x00,0x00,0x00,0x08,0x80,0x04,0x00,0x00,0x11,0x00,0x00,  
-};
+// packed pattern tables (generated from tileset.h)
+#include "chr.h"
 
 #define CHAR(x) ((x)-' ')
 #define BLANK 0
 
-void clrscr() {
-  vrambuf_clear();
-  ppu_off();
-  vram_adr(NAMETABLE_A);
-  vram_fill(BLANK, 32*28);
-  vram_adr(0x0);
-  ppu_on_all();
-}
-
 /////
 
-char in_rect(byte x, byte y, byte x0, byte y0, byte w, byte h) {
-  return ((byte)(x-x0) < w && (byte)(y-y0) < h); // unsigned
-}
-
-void draw_bcd_word(byte col, byte row, word bcd) {
-  byte j;
-  static char buf[4];
-  for (j=3; j<0x80; j--) {
-    buf[j] = CHAR('0'+(bcd&0xf));
-    bcd >>= 4;
-  }
-  vrambuf_put(NTADR_A(col, row), buf, 4);
-}
-
-void draw_bcd_heart(byte col, byte row, byte life) { // pos 27
-  static char buf[3]; 
-  buf[0] = (life >= 3 ) ? CHAR('0' + 43) : CHAR('0' + 44);
-  buf[1] = (life >= 2 ) ? CHAR('0' + 43) : CHAR('0' + 44);
-  buf[2] = (life >= 1 ) ? CHAR('0' + 43) : CHAR('0' + 44);
- 
-  vrambuf_put(NTADR_A(col, row), buf, 3);
-}
-
 // GAME CODE
 
 #define NSPRITES 8	// max number of sprites
@@ -200,136 +131,320 @@ void draw_bcd_heart(byte col, byte row, byte life) { // pos 27
 #define NAME_EXPLODE	112
 #define NAME_ENEMY	68
 
-#define SSRC_FORM1 64	// name for formation source sprites
-#define SDST_FORM1 128	// start of shifted formation table
-
-typedef struct {
-  byte shape;
-} FormationEnemy;
-
-// should be power of 2 length
-typedef struct {
-  byte findex;
-  byte shape;
-  word x;
-  word y;
-  byte dir;
-  byte returning;
-} AttackingEnemy;
-
-typedef struct {
-  byte xpos;
-  byte ypos;
-  signed char dx;
-  signed char dy;
-} Missile;
-
-typedef struct {
-  byte x;
-  byte y;
-  byte name;
-  byte tag;
-} Sprite;
+// sound effects (index SND_DEFS)
+#define SND_SHOT	0
+#define SND_BOOM	1
+#define SND_PLAYER_BOOM	2
+#define SND_DIVE	3
+
 
 #define ENEMIES_PER_ROW 8
 #define ENEMY_ROWS 4
 #define MAX_IN_FORMATION (ENEMIES_PER_ROW*ENEMY_ROWS)
 #define MAX_ATTACKERS 6
 
-FormationEnemy formation[MAX_IN_FORMATION];
-AttackingEnemy attackers[MAX_ATTACKERS];
-Missile missiles[NMISSILES];
-Sprite vsprites[NSPRITES];
-
-byte formation_offset_x;
-signed char formation_direction;
-byte current_row;
-byte player_x;
+byte formation_alive[ENEMY_ROWS];	// bit n = column n present
+
+// entities are kept as parallel byte arrays (struct of arrays)
+// so cc65 can index them with X/Y, no multiply or pointer
+
+// attackers
+byte attacker_findex[MAX_ATTACKERS];	// formation index + 1, 0 = none
+byte attacker_dir[MAX_ATTACKERS];	// heading, 0-63 (0 = down)
+byte attacker_xlo[MAX_ATTACKERS];	// 8.8 position, split so the
+byte attacker_x[MAX_ATTACKERS];		// integer part is a plain byte
+byte attacker_ylo[MAX_ATTACKERS];
+byte attacker_y[MAX_ATTACKERS];
+signed char attacker_turn[MAX_ATTACKERS]; // heading change every 8 frames
+byte attacker_returning[MAX_ATTACKERS];
+
+// missiles
+byte missile_x[NMISSILES];
+byte missile_y[NMISSILES];
+signed char missile_dy[NMISSILES];
+
+// 16x16 sprites
+byte vsprite_x[NSPRITES];
+byte vsprite_y[NSPRITES];
+byte vsprite_name[NSPRITES];
+byte vsprite_tag[NSPRITES];
+
+byte formation_row_x[ENEMY_ROWS];	// offset each row is shown at
 byte player_y = 190;
-byte player_exploding;
-byte enemy_exploding;
-byte enemies_left;
 byte life_count = 3;
-word player_score;
+byte player_score[BCD_BYTES];
+byte high_score[BCD_BYTES];
+
+// what draw_row() last sent for each formation row
+char formation_shadow[ENEMY_ROWS][COLS];
+// alive mask and offset each row was last drawn with
+byte formation_drawn_alive[ENEMY_ROWS];
+byte formation_drawn_x[ENEMY_ROWS];
+
+// clear the screen without turning rendering off
+void clrscr() {
+  vrambuf_clear();
+  memset(formation_shadow, BLANK, sizeof(formation_shadow));
+  memset(formation_drawn_x, 0xff, sizeof(formation_drawn_x)); // none drawn
+  screen_fill(NAMETABLE_A, BLANK, 0);
+}
+
+// OAM layout: reserved player slots first (highest priority),
+// then a rotating pool for everything else, then the stars
+#define OAM_RESERVED	12	// player ship (2 slots) and missile (1)
+#define OAM_STARS	128	// stars take the last 32 slots
+
+// pool objects: vsprite_*[] then missile_*[]
+#define NPOOL (NSPRITES+NMISSILES)
+
+#ifdef DEBUG_OAM_DENSITY
+// hardware sprites touching each 8-line band of the screen:
+// an upper bound on any one line of the band, so more than 8
+// means a line there may be dropping sprites, not that it is
+byte oam_density[33];
+byte oam_density_max;
+
+void measure_oam_density() {
+  register byte i = 0;
+  register byte b;
+  memset(oam_density, 0, sizeof(oam_density));
+  do {
+    b = OAMBUF[i].y;
+    if (b < YOFFSCREEN) {
+      // 8x16 sprites cover lines y+1 to y+16 (2 or 3 bands)
+      if ((b+1) & 7) ++oam_density[(b+16) >> 3];
+      b = (b+1) >> 3;
+      ++oam_density[b];
+      ++oam_density[b+1];
+    }
+  } while (++i < 64);
+  oam_density_max = 0;
+  for (i=0; i<sizeof(oam_density); i++) {
+    if (oam_density[i] > oam_density_max)
+      oam_density_max = oam_density[i];
+  }
+}
+#endif
+
+// OAM shadow as bytes, so writes compile to absolute,y
+#define OAM ((byte*)0x200)
+
+// 16x16 metasprite descriptors, indexed by the flip bits
+// (tag >> 6): tile offsets of the left and right 8x16 halves
+// (sprite names are multiples of 4)
+const byte META16_LEFT[4]  = { 0, 2, 0, 2 };
+const byte META16_RIGHT[4] = { 2, 0, 2, 0 };
+
+// write 16x16 sprite j at OAM byte offset o (advances o)
+#define OAM_META16(o,j) {\
+  byte f = vsprite_tag[j];\
+  byte n = vsprite_name[j];\
+  byte y = vsprite_y[j];\
+  byte x = vsprite_x[j];\
+  OAM[o++] = y;\
+  OAM[o++] = n | META16_LEFT[f >> 6];\
+  OAM[o++] = f;\
+  OAM[o++] = x;\
+  OAM[o++] = y;\
+  OAM[o++] = n | META16_RIGHT[f >> 6];\
+  OAM[o++] = f;\
+  OAM[o++] = x + 8;\
+}
+
+// write missile j at OAM byte offset o (advances o)
+#define OAM_MISSILE(o,j,attr) {\
+  OAM[o++] = missile_y[j];\
+  OAM[o++] = NAME_MISSILE;\
+  OAM[o++] = (attr);\
+  OAM[o++] = missile_x[j];\
+}
 
 void copy_sprites() {
+  register byte o;
+  register byte j;
   byte i;
-  byte oamid = 128; // so we don't clear stars...
-  for (i=0; i<NSPRITES; i++) {
-    Sprite* spr = &vsprites[i];
-    if (spr->y != YOFFSCREEN) {
-      byte y = spr->y;
-      byte x = spr->x;
-      byte chr = spr->name;
-      byte attr = spr->tag;
-      if (attr & 0x40) chr += 2; // horiz flip, swap tiles
-      oamid = oam_spr(x, y, chr, attr, oamid);
-      oamid = oam_spr(x+8, y, chr^2, attr, oamid);
+  // reserved slots: the player always wins its scanlines
+  o = 0;
+  OAM_META16(o, PLYRSPRITE);
+  OAM_MISSILE(o, PLYRMISSILE, COLOR_MISSILE);
+  // the pool starts at a different object every frame, so a
+  // crowded scanline drops a different object each time
+  j = oam_rotate;
+  for (i=0; i<NPOOL; i++) {
+    if (j < NSPRITES) {
+      if (j != PLYRSPRITE && vsprite_y[j] != YOFFSCREEN &&
+          o <= OAM_STARS-8) {
+        OAM_META16(o, j);
+      }
+    } else {
+      j -= NSPRITES;
+      if (j != PLYRMISSILE && missile_y[j] != YOFFSCREEN &&
+          o < OAM_STARS) {
+        OAM_MISSILE(o, j, COLOR_BOMB);
+      }
+      j += NSPRITES;
     }
+    if (++j == NPOOL) j = 0;
   }
-  // copy all "shadow missiles" to video memory
-  for (i=0; i<NMISSILES; i++) {
-    Missile* mis = &missiles[i];
-    if (mis->ypos != YOFFSCREEN) {
-      oamid = oam_spr(mis->xpos, mis->ypos, NAME_MISSILE,
-                      (i==7)?COLOR_MISSILE:COLOR_BOMB,
-                      oamid);
-    }
+  if (++oam_rotate == NPOOL) oam_rotate = 0;
+  // hide the rest of the pool, but not the stars
+  for ( ; o < OAM_STARS; o += 4) {
+    OAM[o] = YOFFSCREEN;
   }
-  oam_hide_rest(oamid);
+#ifdef DEBUG_OAM_DENSITY
+  measure_oam_density();
+#endif
 }
 
-void add_score(word bcd) {
-  player_score = bcd_add(player_score, bcd);
-  draw_bcd_word(1, 1, player_score);
-  draw_bcd_heart(28, 1, life_count);
+// bcd is two BCD digits (0x00-0x99)
+void add_score(byte bcd) {
+  bcd_add8(player_score, bcd);
+  if (bcd_cmp(player_score, high_score) > 0)
+    memcpy(high_score, player_score, BCD_BYTES);
 }
 
-void clrobjs() {
-  byte i;
-  memset(vsprites, 0, sizeof(vsprites));
-  for (i=0; i<NSPRITES; i++) {
-    vsprites[i].y = YOFFSCREEN;
-  }
-  for (i=0; i<NMISSILES; i++) {
-    missiles[i].ypos = YOFFSCREEN;
+// HUD
+
+#define HUD_SCORE	NTADR_A(1,1)
+#define HUD_HIGH	NTADR_A(13,1)
+#define HUD_HEARTS	NTADR_A(28,1)
+#define HEART_FULL	CHAR('0'+43)
+#define HEART_EMPTY	CHAR('0'+44)
+
+// what's on screen, so each frame only sends what changed
+static char hud_score_shown[BCD_DIGITS];
+static char hud_high_shown[BCD_DIGITS];
+static char hud_hearts_shown[3];
+// values last sent in full (0xff is never BCD); the high
+// score only changes along with the score
+static byte hud_score[BCD_BYTES];
+static byte hud_lives;
+
+// forget what's on screen (after clearing it)
+void hud_reset() {
+  memset(hud_score_shown, 0xff, sizeof(hud_score_shown));
+  memset(hud_high_shown, 0xff, sizeof(hud_high_shown));
+  memset(hud_hearts_shown, 0xff, sizeof(hud_hearts_shown));
+  memset(hud_score, 0xff, sizeof(hud_score));
+  hud_lives = 0xff;
+}
+
+// queue the span of str that differs from shown, if it fits
+// this frame's VRAM budget (so it can't force a flush);
+// returns 0 if it has to wait for the next frame
+byte hud_put(word addr, const char* str, char* shown, byte len) {
+  register byte first = 0;
+  register byte last = len-1;
+  while (first < len && str[first] == shown[first]) ++first;
+  if (first == len) return 1;
+  while (str[last] == shown[last]) --last;
+  len = last - first + 1;
+  if (!VRAMBUF_FITS(len)) return 0;
+  memcpy(shown+first, str+first, len);
+  vrambuf_put(addr+first, str+first, len);
+  return 1;
+}
+
+// send the score digits and hearts that changed, once a frame
+void draw_hud() {
+  static char buf[BCD_DIGITS];
+  byte sent;
+  if (!memcmp(player_score, hud_score, BCD_BYTES) && life_count == hud_lives)
+    return;
+  bcd_to_tiles(buf, player_score, CHAR('0'));
+  sent = hud_put(HUD_SCORE, buf, hud_score_shown, BCD_DIGITS);
+  bcd_to_tiles(buf, high_score, CHAR('0'));
+  sent &= hud_put(HUD_HIGH, buf, hud_high_shown, BCD_DIGITS);
+  buf[0] = life_count >= 3 ? HEART_FULL : HEART_EMPTY;
+  buf[1] = life_count >= 2 ? HEART_FULL : HEART_EMPTY;
+  buf[2] = life_count >= 1 ? HEART_FULL : HEART_EMPTY;
+  sent &= hud_put(HUD_HEARTS, buf, hud_hearts_shown, 3);
+  if (sent) {
+    memcpy(hud_score, player_score, BCD_BYTES);
+    hud_lives = life_count;
   }
 }
 
+void clrobjs() {
+  memset(vsprite_name, 0, sizeof(vsprite_name));
+  memset(vsprite_tag, 0, sizeof(vsprite_tag));
+  memset(vsprite_x, 0, sizeof(vsprite_x));
+  memset(vsprite_y, YOFFSCREEN, sizeof(vsprite_y));
+  memset(missile_y, YOFFSCREEN, sizeof(missile_y));
+}
+
 void setup_formation() {
-  byte i;
-  memset(formation, 0, sizeof(formation));
-  memset(attackers, 0, sizeof(attackers));
-  for (i=0; i<MAX_IN_FORMATION; i++) {
-    byte flagship = i < ENEMIES_PER_ROW;
-    formation[i].shape = flagship ? SDST_FORM1 : SDST_FORM1;
-  }
-  enemies_left = MAX_IN_FORMATION;
+  memset(attacker_findex, 0, sizeof(attacker_findex));
+  memset(formation_alive, 0xff, sizeof(formation_alive));
   formation_offset_x = 8;
+  memset(formation_row_x, 8, sizeof(formation_row_x));
 }
 
+// bit for each column in a row's alive mask
+const byte COLUMN_BIT[ENEMIES_PER_ROW] = {
+  0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80
+};
+
+#define SET_ALIVE(fi) \
+  formation_alive[(fi) / ENEMIES_PER_ROW] |= COLUMN_BIT[(fi) & 7]
+#define CLEAR_ALIVE(fi) \
+  formation_alive[(fi) / ENEMIES_PER_ROW] &= ~COLUMN_BIT[(fi) & 7]
+#define IS_ALIVE(fi) \
+  (formation_alive[(fi) / ENEMIES_PER_ROW] & COLUMN_BIT[(fi) & 7])
+
+// number of set bits in a nibble
+const byte NIBBLE_BITS[16] = {
+  0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+};
+
+#ifdef FORMATION_IRQ
+// the band splits move the rows; tiles only change on a kill
+#define ROW_DRAW_X(row) 0
+#else
+#define ROW_DRAW_X(row) formation_row_x[row]
+#endif
+
+// compose a row straight from its alive mask:
+// each enemy is its 3 tile names ANDed with 0 or $ff
 void draw_row(byte row) {
-  static char buf[32];
-  register byte i;
-  register byte x = formation_offset_x / 8;
-  byte xd = (formation_offset_x & 7) * 3;
+  static char buf[COLS];
+  register char* p = buf;
+  register byte n;
+  byte alive = formation_alive[row];
+  byte x = ROW_DRAW_X(row);
+  byte t0 = CHR_PHASE0[x & 7];
+  byte t1 = CHR_PHASE1[x & 7];
+  byte t2 = CHR_PHASE2[x & 7];
+  byte m;
   byte y = 3 + row * 2;
-  memset(buf, BLANK, sizeof(buf));
-  for (i=0; i<ENEMIES_PER_ROW; i++) {
-    byte shape = formation[i + row*ENEMIES_PER_ROW].shape;
-    if (shape) {
-      shape += xd;
-      buf[x] = shape;
-      buf[x+1] = shape+1;
-      buf[x+2] = shape+2;
-    }
-    x += 3;
+  // blank left margin
+  for (n = x >> 3; n; --n) {
+    *p++ = BLANK;
+  }
+  for (n = ENEMIES_PER_ROW; n; --n) {
+    m = -(alive & 1);
+    p[0] = t0 & m;
+    p[1] = t1 & m;
+    p[2] = t2 & m;
+    p += 3;
+    alive >>= 1;
+  }
+  // blank right margin
+  while (p != buf+COLS) {
+    *p++ = BLANK;
   }
-  vrambuf_put(NTADR_A(0, y), buf, sizeof(buf));
+  // only send the tiles that changed since last time
+  vrambuf_put_diff(NTADR_A(0, y), buf, formation_shadow[row], sizeof(buf));
 }
 
-void draw_next_row() {
-  draw_row(current_row);
+// scheduler cost of redrawing a row (64ths of a frame)
+#define COST_DRAW_ROW 4
+
+// redraw every row whose alive mask or offset changed;
+// the offset still ripples down one row per frame
+void draw_formation() {
+  register byte row;
+  formation_row_x[current_row] = formation_offset_x;
   if (++current_row == ENEMY_ROWS) {
     current_row = 0;
     formation_offset_x += formation_direction;
@@ -340,126 +455,265 @@ void draw_next_row() {
       formation_direction = 1;
     }
   }
+  for (row=0; row<ENEMY_ROWS; row++) {
+    if (formation_alive[row] != formation_drawn_alive[row] ||
+        ROW_DRAW_X(row) != formation_drawn_x[row]) {
+      formation_drawn_alive[row] = formation_alive[row];
+      formation_drawn_x[row] = ROW_DRAW_X(row);
+      draw_row(row);
+      sched_spent += COST_DRAW_ROW;
+    }
+  }
+}
+
+// wing-flap frame of the formation tiles (or being streamed)
+byte formation_flap;
+
+#ifdef FORMATION_IRQ
+#define FLAP_PHASES 1	// rows are always drawn at phase 0
+#else
+#define FLAP_PHASES 8
+#endif
+
+// stream the other wing-flap frame into the shifted tiles, one
+// upload per pixel phase so each phase flips in one vblank;
+// every enemy animates with no nametable writes
+void flap_formation() {
+  register byte i;
+  const byte* src;
+  if (chrq_busy())
+    return;
+  formation_flap ^= 1;
+  src = formation_flap ? CHR_FLAP1 : CHR_FLAP0;
+  for (i=0; i<FLAP_PHASES; i++) {
+    chrq_put(CHR_FLAP_ADDR + CHR_FLAP_FIRST[i]*16,
+             src + CHR_FLAP_DATA[i]*16, CHR_FLAP_COUNT[i]);
+  }
 }
 
 #define FLIPX 0x40
 #define FLIPY 0x80
 #define FLIPXY 0xc0
 
-const byte DIR_TO_CODE[32] = {
-  0|FLIPXY, 1|FLIPXY, 2|FLIPXY, 3|FLIPXY, 4|FLIPXY, 5|FLIPXY, 6|FLIPXY, 6|FLIPXY,
-  6|FLIPX, 6|FLIPX, 5|FLIPX, 4|FLIPX, 3|FLIPX, 2|FLIPX, 1|FLIPX, 0|FLIPX,
-  0, 1, 2, 3, 4, 5, 6, 6,
-  6|FLIPY, 6|FLIPY, 5|FLIPY, 4|FLIPY, 3|FLIPY, 2|FLIPY, 1|FLIPY, 0|FLIPY,
+const byte DIR_TO_CODE[64] = {
+  0|FLIPXY, 0|FLIPXY, 1|FLIPXY, 1|FLIPXY, 2|FLIPXY, 2|FLIPXY, 3|FLIPXY, 3|FLIPXY,
+  4|FLIPXY, 4|FLIPXY, 5|FLIPXY, 5|FLIPXY, 6|FLIPXY, 6|FLIPXY, 6|FLIPXY, 6|FLIPXY,
+  6|FLIPX, 6|FLIPX, 6|FLIPX, 6|FLIPX, 5|FLIPX, 5|FLIPX, 4|FLIPX, 4|FLIPX,
+  3|FLIPX, 3|FLIPX, 2|FLIPX, 2|FLIPX, 1|FLIPX, 1|FLIPX, 0|FLIPX, 0|FLIPX,
+  0, 0, 1, 1, 2, 2, 3, 3,
+  4, 4, 5, 5, 6, 6, 6, 6,
+  6|FLIPY, 6|FLIPY, 6|FLIPY, 6|FLIPY, 5|FLIPY, 5|FLIPY, 4|FLIPY, 4|FLIPY,
+  3|FLIPY, 3|FLIPY, 2|FLIPY, 2|FLIPY, 1|FLIPY, 1|FLIPY, 0|FLIPY, 0|FLIPY,
 };
 
-// sine table, pre-multiplied by 2
-const int SINTBL2[32] = {
-  0, 25*2, 49*2, 71*2, 90*2, 106*2, 117*2, 125*2,
-  127*2, 125*2, 117*2, 106*2, 90*2, 71*2, 49*2, 25*2,
-  0*2, -25*2, -49*2, -71*2, -90*2, -106*2, -117*2, -125*2,
-  -127*2, -125*2, -117*2, -106*2, -90*2, -71*2, -49*2, -25*2,
+// per-frame velocity for 64 headings, 8.8 fixed point
+// (2*127*sin), split into low and high bytes; the
+// extra 16 entries let cos index with +16 and no mask
+const byte VEL_LO[80] = {
+  0x00, 0x19, 0x32, 0x4a, 0x61, 0x78, 0x8d, 0xa1,
+  0xb4, 0xc4, 0xd3, 0xe0, 0xeb, 0xf3, 0xf9, 0xfd,
+  0xfe, 0xfd, 0xf9, 0xf3, 0xeb, 0xe0, 0xd3, 0xc4,
+  0xb4, 0xa1, 0x8d, 0x78, 0x61, 0x4a, 0x32, 0x19,
+  0x00, 0xe7, 0xce, 0xb6, 0x9f, 0x88, 0x73, 0x5f,
+  0x4c, 0x3c, 0x2d, 0x20, 0x15, 0x0d, 0x07, 0x03,
+  0x02, 0x03, 0x07, 0x0d, 0x15, 0x20, 0x2d, 0x3c,
+  0x4c, 0x5f, 0x73, 0x88, 0x9f, 0xb6, 0xce, 0xe7,
+  0x00, 0x19, 0x32, 0x4a, 0x61, 0x78, 0x8d, 0xa1,
+  0xb4, 0xc4, 0xd3, 0xe0, 0xeb, 0xf3, 0xf9, 0xfd,
+};
+const byte VEL_HI[80] = {
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
-#define ISIN(x) (SINTBL2[(x) & 31])
-#define ICOS(x) ISIN(x+8)
+#define DIRMASK 63
+#define VCOS(d) ((d)+16)
 
 #define FORMATION_X0 0
 #define FORMATION_Y0 19
 #define FORMATION_XSPACE 24
 #define FORMATION_YSPACE 16
 
+// x of each column relative to formation_offset_x
+const byte COLUMN_X[ENEMIES_PER_ROW] = {
+  FORMATION_X0+0*FORMATION_XSPACE, FORMATION_X0+1*FORMATION_XSPACE,
+  FORMATION_X0+2*FORMATION_XSPACE, FORMATION_X0+3*FORMATION_XSPACE,
+  FORMATION_X0+4*FORMATION_XSPACE, FORMATION_X0+5*FORMATION_XSPACE,
+  FORMATION_X0+6*FORMATION_XSPACE, FORMATION_X0+7*FORMATION_XSPACE,
+};
+
+// y of each row
+const byte ROW_Y[ENEMY_ROWS] = {
+  FORMATION_Y0+0*FORMATION_YSPACE, FORMATION_Y0+1*FORMATION_YSPACE,
+  FORMATION_Y0+2*FORMATION_YSPACE, FORMATION_Y0+3*FORMATION_YSPACE,
+};
+
+#define X 0xff
+
+// column hit at each x relative to formation_offset_x
+// (X = between enemies or past the last column)
+const byte FORMATION_XCOL[256] = {
+  0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+  X,X,X,X,X,X,X,X,1,1,1,1,1,1,1,1,
+  1,1,1,1,1,1,1,1,X,X,X,X,X,X,X,X,
+  2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,
+  X,X,X,X,X,X,X,X,3,3,3,3,3,3,3,3,
+  3,3,3,3,3,3,3,3,X,X,X,X,X,X,X,X,
+  4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,
+  X,X,X,X,X,X,X,X,5,5,5,5,5,5,5,5,
+  5,5,5,5,5,5,5,5,X,X,X,X,X,X,X,X,
+  6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,
+  X,X,X,X,X,X,X,X,7,7,7,7,7,7,7,7,
+  7,7,7,7,7,7,7,7,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+};
+
+// row hit at each y (X = above or below the formation)
+const byte FORMATION_YROW[256] = {
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,0,0,0,0,0,0,0,0,0,0,0,0,0,
+  0,0,0,1,1,1,1,1,1,1,1,1,1,1,1,1,
+  1,1,1,2,2,2,2,2,2,2,2,2,2,2,2,2,
+  2,2,2,3,3,3,3,3,3,3,3,3,3,3,3,3,
+  3,3,3,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+};
+
+#undef X
+
 byte get_attacker_x(byte formation_index) {
-  byte column = (formation_index % ENEMIES_PER_ROW);
-  return FORMATION_XSPACE*column + FORMATION_X0 + formation_offset_x;
+  return COLUMN_X[formation_index & 7] + formation_offset_x;
 }
 
 byte get_attacker_y(byte formation_index) {
-  byte row = formation_index / ENEMIES_PER_ROW;
-  return FORMATION_YSPACE*row + FORMATION_Y0;
-}
-
-void draw_attacker(byte i) {
-  AttackingEnemy* a = &attackers[i];
-  if (a->findex) {
-    byte code = DIR_TO_CODE[a->dir & 31];
-    vsprites[i].name = NAME_ENEMY + (code & 7)*4; // tile
-    vsprites[i].tag = code & FLIPXY; // flip h/v
-    vsprites[i].x = a->x >> 8;
-    vsprites[i].y = a->y >> 8;
-  } else {
-    vsprites[i].y = YOFFSCREEN;
+  return ROW_Y[formation_index / ENEMIES_PER_ROW];
+}
+
+// formation bits plus attackers in flight
+byte count_enemies() {
+  register byte i;
+  register byte m;
+  byte n = 0;
+  for (i=0; i<ENEMY_ROWS; i++) {
+    m = formation_alive[i];
+    n += NIBBLE_BITS[m & 15] + NIBBLE_BITS[m >> 4];
+  }
+  for (i=0; i<MAX_ATTACKERS; i++) {
+    if (attacker_findex[i]) n++;
   }
+  return n;
 }
 
 void draw_attackers() {
-  byte i;
+  register byte i;
+  byte code;
   for (i=0; i<MAX_ATTACKERS; i++) {
-    draw_attacker(i);
+    if (attacker_findex[i]) {
+      code = DIR_TO_CODE[attacker_dir[i]];
+      vsprite_name[i] = NAME_ENEMY + (code & 7)*4; // tile
+      vsprite_tag[i] = code & FLIPXY; // flip h/v
+      vsprite_x[i] = attacker_x[i];
+      vsprite_y[i] = attacker_y[i];
+    } else {
+      vsprite_y[i] = YOFFSCREEN;
+    }
   }
 }
 
-void return_attacker(register AttackingEnemy* a) {
-  byte fi = a->findex-1;
+void return_attacker(register byte i) {
+  byte fi = attacker_findex[i]-1;
   byte destx = get_attacker_x(fi);
   byte desty = get_attacker_y(fi);
-  byte ydist = desty - (a->y >> 8);
+  byte ydist = desty - attacker_y[i];
   // are we close to our formation slot?
   if (ydist == 0) {
     // convert back to formation enemy
-    formation[fi].shape = a->shape;
-    a->findex = 0;
+    SET_ALIVE(fi);
+    attacker_findex[i] = 0;
   } else {
-    a->dir = (ydist + 16) & 31;
-    a->x = destx << 8;
-    a->y += 128;
+    attacker_dir[i] = (ydist*2 + 32) & DIRMASK;
+    attacker_x[i] = destx;
+    attacker_xlo[i] = 0;
+    // y += 0.5
+    if ((attacker_ylo[i] += 128) < 128) attacker_y[i]++;
   }
 }
 
-void fly_attacker(register AttackingEnemy* a) {
-  a->x += ISIN(a->dir);
-  a->y += ICOS(a->dir);
-  if ((a->y >> 8) == 0) {
-    a->returning = 1;
+void fly_attacker(register byte i) {
+  register byte d = attacker_dir[i];
+  byte lo;
+  // 8.8 adds, one byte at a time; carry is (lo < old lo)
+  lo = attacker_xlo[i] + VEL_LO[d];
+  attacker_x[i] += VEL_HI[d] + (lo < attacker_xlo[i]);
+  attacker_xlo[i] = lo;
+  d = VCOS(d);
+  lo = attacker_ylo[i] + VEL_LO[d];
+  attacker_y[i] += VEL_HI[d] + (lo < attacker_ylo[i]);
+  attacker_ylo[i] = lo;
+  if (attacker_y[i] == 0) {
+    attacker_returning[i] = 1;
   }
 }
 
+// attacker i thinks on frames 2*i (mod 16), and finishes
+// its turn 8 frames later
 void move_attackers() {
-  byte i;
+  register byte i;
+  byte turning = (sched_frame & 1) ? 0xff : ((sched_frame >> 1) + 4) & 7;
   for (i=0; i<MAX_ATTACKERS; i++) {
-    AttackingEnemy* a = &attackers[i];
-    if (a->findex) {
-      if (a->returning)
-        return_attacker(a);
-      else
-        fly_attacker(a);
+    if (attacker_findex[i]) {
+      if (attacker_returning[i])
+        return_attacker(i);
+      else {
+        if (i == turning)
+          attacker_dir[i] = (attacker_dir[i] + attacker_turn[i]) & DIRMASK;
+        fly_attacker(i);
+      }
     }
   }
 }
 
+// one attacker per call, so thinking is spread over frames
 void think_attackers() {
-  byte i;
-  for (i=0; i<MAX_ATTACKERS; i++) {
-    AttackingEnemy* a = &attackers[i];
-    if (a->findex) {
-      // rotate?
-      byte x = a->x >> 8;
-      byte y = a->y >> 8;
-      // don't shoot missiles after player exploded
-      if (y < 112 || player_exploding) {
-        if (x < 128) {
-          a->dir++;
-        } else {
-          a->dir--;
-        }
-      } else {
-        // lower half of screen
-        // shoot a missile?
-        if (missiles[i].ypos == YOFFSCREEN) {
-          missiles[i].ypos = y+16;
-          missiles[i].xpos = x;
-          missiles[i].dy = 2;
-        }
+  register byte i = (sched_frame >> 1) & 7;
+  byte x, y;
+  if (i < MAX_ATTACKERS && attacker_findex[i]) {
+    // rotate?
+    x = attacker_x[i];
+    y = attacker_y[i];
+    // don't shoot missiles after player exploded
+    if (y < 112 || player_exploding) {
+      // half a turn now, half in move_attackers()
+      attacker_turn[i] = (x < 128) ? 1 : -1;
+      attacker_dir[i] = (attacker_dir[i] + attacker_turn[i]) & DIRMASK;
+    } else {
+      attacker_turn[i] = 0;
+      // lower half of screen
+      // shoot a missile?
+      if (missile_y[i] == YOFFSCREEN) {
+        missile_y[i] = y+16;
+        missile_x[i] = x;
+        missile_dy[i] = 2;
       }
     }
   }
@@ -471,63 +725,65 @@ void formation_to_attacker(byte formation_index) {
   if (formation_index >= MAX_IN_FORMATION)
     return;
   // nobody in formation? return
-  if (!formation[formation_index].shape)
+  if (!IS_ALIVE(formation_index))
     return;
   // find an empty attacker slot
   for (i=0; i<MAX_ATTACKERS; i++) {
-    AttackingEnemy* a = &attackers[i];
-    if (a->findex == 0) {
-      a->x = get_attacker_x(formation_index) << 8;
-      a->y = get_attacker_y(formation_index) << 8;
-      a->shape = formation[formation_index].shape;
-      a->findex = formation_index+1;
-      a->dir = 0;
-      a->returning = 0;
-      formation[formation_index].shape = 0;
+    if (attacker_findex[i] == 0) {
+      attacker_x[i] = get_attacker_x(formation_index);
+      attacker_y[i] = get_attacker_y(formation_index);
+      attacker_xlo[i] = attacker_ylo[i] = 0;
+      attacker_findex[i] = formation_index+1;
+      attacker_dir[i] = 0;
+      attacker_turn[i] = 0;
+      attacker_returning[i] = 0;
+      CLEAR_ALIVE(formation_index);
+      snd_play(SND_DIVE);
       break;
     }
   }
 }
 
 void draw_player() {
-  vsprites[PLYRSPRITE].x = player_x;
-  vsprites[PLYRSPRITE].y = player_y;
-  vsprites[PLYRSPRITE].name = NAME_SHIP;
-  vsprites[PLYRSPRITE].tag = COLOR_PLAYER;
+  vsprite_x[PLYRSPRITE] = player_x;
+  vsprite_y[PLYRSPRITE] = player_y;
+  vsprite_name[PLYRSPRITE] = NAME_SHIP;
+  vsprite_tag[PLYRSPRITE] = COLOR_PLAYER;
 }
 
-void move_player() {
-  byte joy = pad_poll(0);
+void move_player(byte joy) {
   // move left/right?
   if ((joy & PAD_LEFT) && player_x > 16) player_x--;
   if ((joy & PAD_RIGHT) && player_x < 224) player_x++;
   // shoot missile?
-  if ((joy & PAD_A) && missiles[PLYRMISSILE].ypos == YOFFSCREEN) {
-    missiles[PLYRMISSILE].ypos = player_y-8; // must be multiple of missile speed
-    missiles[PLYRMISSILE].xpos = player_x+4; // player X position
-    missiles[PLYRMISSILE].dy = -4; // player missile speed
+  if ((joy & PAD_A) && missile_y[PLYRMISSILE] == YOFFSCREEN) {
+    missile_y[PLYRMISSILE] = player_y-8; // must be multiple of missile speed
+    missile_x[PLYRMISSILE] = player_x+4; // player X position
+    missile_dy[PLYRMISSILE] = -4; // player missile speed
+    snd_play(SND_SHOT);
   }
-  vsprites[PLYRMISSILE].x = player_x;
+  vsprite_x[PLYRSPRITE] = player_x;
 }
 
 void move_missiles() {
-  byte i;
-  for (i=0; i<8; i++) { 
-    if (missiles[i].ypos != YOFFSCREEN) {
+  register byte i;
+  for (i=0; i<NMISSILES; i++) { 
+    if (missile_y[i] != YOFFSCREEN) {
       // hit the bottom or top?
-      if ((byte)(missiles[i].ypos += missiles[i].dy) > YOFFSCREEN) {
-        missiles[i].ypos = YOFFSCREEN;
+      if ((byte)(missile_y[i] += missile_dy[i]) > YOFFSCREEN) {
+        missile_y[i] = YOFFSCREEN;
       }
     }
   }
 }
 
 void blowup_at(byte x, byte y) {
-  vsprites[BOOMSPRITE].tag = COLOR_EXPLOSION;
-  vsprites[BOOMSPRITE].name = NAME_EXPLODE; // TODO
-  vsprites[BOOMSPRITE].x = x;
-  vsprites[BOOMSPRITE].y = y;
+  vsprite_tag[BOOMSPRITE] = COLOR_EXPLOSION;
+  vsprite_name[BOOMSPRITE] = NAME_EXPLODE; // TODO
+  vsprite_x[BOOMSPRITE] = x;
+  vsprite_y[BOOMSPRITE] = y;
   enemy_exploding = 1;
+  snd_play(SND_BOOM);
 }
 
 void animate_enemy_explosion() {
@@ -535,9 +791,9 @@ void animate_enemy_explosion() {
     // animate next frame
     if (enemy_exploding >= 8) {
       enemy_exploding = 0; // hide explosion after 4 frames
-      vsprites[BOOMSPRITE].y = YOFFSCREEN;
+      vsprite_y[BOOMSPRITE] = YOFFSCREEN;
     } else {
-      vsprites[BOOMSPRITE].name = NAME_EXPLODE + (enemy_exploding += 4); // TODO
+      vsprite_name[BOOMSPRITE] = NAME_EXPLODE + (enemy_exploding += 4); // TODO
     }
   }
 }
@@ -546,58 +802,16 @@ void animate_player_explosion() {
   byte z = player_exploding;
   if (z <= 3) {
     if (z == 3) {
-      vsprites[PLYRSPRITE].y = YOFFSCREEN;
+      vsprite_y[PLYRSPRITE] = YOFFSCREEN;
     } else {
-      vsprites[PLYRSPRITE].name = NAME_EXPLODE + z*4;
+      vsprite_name[PLYRSPRITE] = NAME_EXPLODE + z*4;
     }
   }
 }
 
 void hide_player_missile() {
-  missiles[PLYRMISSILE].ypos = YOFFSCREEN;
-}
-
-void does_player_shoot_formation() {
-  byte mx = missiles[PLYRMISSILE].xpos + 4;
-  byte my = missiles[PLYRMISSILE].ypos;
-  signed char row = (my - FORMATION_Y0) / FORMATION_YSPACE;
-  if (missiles[PLYRMISSILE].ypos == YOFFSCREEN)
-    return;
-  if (row >= 0 && row < ENEMY_ROWS) {
-    // ok if unsigned (in fact, must be due to range)
-    byte xoffset = mx - FORMATION_X0 - formation_offset_x;
-    byte column = xoffset / FORMATION_XSPACE;
-    byte localx = xoffset - column * FORMATION_XSPACE;
-    if (column < ENEMIES_PER_ROW && localx < 16) {
-      char index = column + row * ENEMIES_PER_ROW;
-      if (formation[index].shape) {
-        formation[index].shape = 0;
-        enemies_left--;
-        blowup_at(get_attacker_x(index), get_attacker_y(index));
-        hide_player_missile();
-        add_score(2);
-      }
-    }
-  }
-}
-
-void does_player_shoot_attacker() {
-  byte mx = missiles[PLYRMISSILE].xpos + 4;
-  byte my = missiles[PLYRMISSILE].ypos;
-  byte i;
-  if (missiles[PLYRMISSILE].ypos == YOFFSCREEN)
-    return;
-  for (i=0; i<MAX_ATTACKERS; i++) {
-    AttackingEnemy* a = &attackers[i];
-    if (a->findex && in_rect(mx, my, a->x >> 8, a->y >> 8, 16, 16)) {
-      blowup_at(a->x >> 8, a->y >> 8);
-      a->findex = 0;
-      enemies_left--;
-      hide_player_missile();
-      add_score(5);
-      break;
-    }
-  }
+  missile_y[PLYRMISSILE] = YOFFSCREEN;
+  snd_stop(SND_SHOT);
 }
 
 void new_player_ship() {
@@ -608,10 +822,7 @@ void new_player_ship() {
 
 void restart_game() {
   life_count = 3;
-  player_score = 0;
-  draw_bcd_word(1, 1, player_score);
-  draw_bcd_heart(28, 1, life_count);
-  add_score(0);
+  memset(player_score, 0, BCD_BYTES);
   //putbytes(NTADR_A(0, 1), "PLAYER 1", 8);
   setup_formation();
   clrobjs();
@@ -619,32 +830,135 @@ void restart_game() {
   new_player_ship();
 }
 
-void does_missile_hit_player() {
-  byte i;
-  if (player_exploding)
+// COLLISION
+
+// Every hit test, once a frame after everything has moved.
+// A missile tests the whole y span it swept this frame, so it
+// can't step over a target however fast it goes. Attackers are
+// binned into 32-line bands first, and the player missile only
+// looks at them when its span shares a band with one; each
+// missile and attacker is visited at most twice.
+
+// bit for each 32-line band of the screen
+const byte BAND_BIT[8] = {
+  0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80
+};
+
+// bands touched by lines lo to lo+span
+#define BANDS(lo,span) \
+  (BAND_BIT[(lo) >> 5] | BAND_BIT[(byte)((lo)+(span)) >> 5])
+
+// do lines lo to lo+span overlap y0 to y0+h-1? (unsigned)
+#define SPAN_HITS(lo,span,y0,h) \
+  ((byte)((lo)+(span)-(y0)) < (byte)((h)+(span)))
+
+// an attacker and the ship collide closer than this both ways
+#define BODY_NEAR 12
+
+// returns 1 if that was the last life (the game restarted)
+byte player_hit() {
+  player_exploding = 1;
+  snd_play(SND_PLAYER_BOOM);
+  --life_count;
+  if (life_count == 0) {
+    restart_game();
+    return 1;
+  }
+  return 0;
+}
+
+void attacker_hit(register byte i) {
+  blowup_at(attacker_x[i], attacker_y[i]);
+  attacker_findex[i] = 0;
+}
+
+// the missile's tip (x+4) swept up from y+span to y;
+// bands are the ones holding attackers
+void player_missile_hits(byte bands) {
+  byte mx = missile_x[PLYRMISSILE] + 4;
+  byte my = missile_y[PLYRMISSILE];
+  byte span = -missile_dy[PLYRMISSILE];
+  register byte i;
+  byte row, column;
+  if (my == YOFFSCREEN)
+    return;
+  // rows are taller than the span, so it is in one or two;
+  // the lower one was reached first
+  column = FORMATION_XCOL[(byte)(mx - formation_offset_x)];
+  if (column < ENEMIES_PER_ROW) {
+    row = FORMATION_YROW[(byte)(my + span)];
+    if (row >= ENEMY_ROWS || !(formation_alive[row] & COLUMN_BIT[column]))
+      row = FORMATION_YROW[my];
+    if (row < ENEMY_ROWS && (formation_alive[row] & COLUMN_BIT[column])) {
+      formation_alive[row] &= ~COLUMN_BIT[column];
+      blowup_at(COLUMN_X[column] + formation_offset_x, ROW_Y[row]);
+      hide_player_missile();
+      add_score(2);
+      return;
+    }
+  }
+  if (!(BANDS(my, span) & bands))
     return;
   for (i=0; i<MAX_ATTACKERS; i++) {
-    if (missiles[i].ypos != YOFFSCREEN && 
-        in_rect(missiles[i].xpos, missiles[i].ypos + 16, 
-                player_x, player_y, 16, 16)) {
-      player_exploding = 1;
-      draw_bcd_heart(28, 1, --life_count);
-      if(life_count == 0) {
-        restart_game();
-      }
+    if (attacker_findex[i] &&
+        (byte)(mx - attacker_x[i]) < 16 &&
+        SPAN_HITS(my, span, attacker_y[i], 16)) {
+      attacker_hit(i);
+      hide_player_missile();
+      add_score(5);
       break;
     }
   }
 }
 
+void collide() {
+  register byte i;
+  byte y, span;
+  byte bands = 0;
+  byte alive = !player_exploding;
+  // attackers: bin them, and see if one rams the ship
+  for (i=0; i<MAX_ATTACKERS; i++) {
+    if (attacker_findex[i]) {
+      y = attacker_y[i];
+      if (alive &&
+          (byte)(y - player_y + BODY_NEAR) <= 2*BODY_NEAR &&
+          (byte)(attacker_x[i] - player_x + BODY_NEAR) <= 2*BODY_NEAR) {
+        attacker_hit(i);
+        // the game restarted: nothing left to test
+        if (player_hit())
+          return;
+        alive = 0;
+        continue; // gone, so not binned
+      }
+      bands |= BANDS(y, 15);
+    }
+  }
+  player_missile_hits(bands);
+  if (!alive)
+    return;
+  // enemy missiles: the sprite's bottom swept down to y+16
+  for (i=0; i<NMISSILES; i++) {
+    y = missile_y[i];
+    if (i != PLYRMISSILE && y != YOFFSCREEN) {
+      span = missile_dy[i];
+      y = y + 16 - span;
+      if (SPAN_HITS(y, span, player_y, 16) &&
+          (byte)(missile_x[i] - player_x) < 16) {
+        player_hit();
+        break;
+      }
+    }
+  }
+}
+
 void new_attack_wave() {
-  byte i = rand();
+  byte i = rand8();
   byte j;
   // find a random slot that has an enemy
   for (j=0; j<MAX_IN_FORMATION; j++) {
     i = (i+1) & (MAX_IN_FORMATION-1);
     // anyone there?
-    if (formation[i].shape) {
+    if (IS_ALIVE(i)) {
       formation_to_attacker(i);
       formation_to_attacker(i+1);
       formation_to_attacker(i+ENEMIES_PER_ROW);
@@ -654,46 +968,64 @@ void new_attack_wave() {
   }
 }
 
-void set_sounds() {
-  byte i;
-  // these channels decay, so ok to always enable
-  byte enable = ENABLE_PULSE0|ENABLE_PULSE1|ENABLE_NOISE;
-  // missile fire sound
-  if (missiles[PLYRMISSILE].ypos != YOFFSCREEN) {
-    APU_PULSE_SUSTAIN(0, 255-missiles[PLYRMISSILE].ypos, DUTY_50, 6);
-  } else {
-    APU_PULSE_SET_VOLUME(0, DUTY_50, 0);
-  }
-  // enemy explosion sound
-  if (player_exploding && player_exploding < 8) {
-    APU_NOISE_DECAY(8 + player_exploding, 5, 15);
-  } else if (enemy_exploding) {
-    APU_NOISE_DECAY(8 + enemy_exploding, 2, 8);
-  }
-  // set diving sounds for spaceships
-  for (i=0; i<2; i++) {
-    register AttackingEnemy* a = i ? &attackers[4] : &attackers[0];
-    if (a->findex && !a->returning) {
-      byte y = a->y >> 8;
-      APU_TRIANGLE_SUSTAIN(0x100 | y);
-      enable |= ENABLE_TRIANGLE;
-      break;
-    }
-  }
-  APU_ENABLE(enable);
-}
+// SOUND EFFECTS
+
+// offsets of each volume script in SND_VOLS
+#define VOL_SHOT	0
+#define VOL_BOOM	2
+#define VOL_PLAYER_BOOM	15
+#define VOL_DIVE	62
+
+// effects only use pulse 2 and noise, where they
+// override the music while they play
+const byte SND_VOLS[] = {
+  // shot
+  6,SND_HOLD,
+  // boom
+  15,13,11,9,7,6,5,4,3,2,1,0,SND_HOLD,
+  // player boom
+  15,15,15,14,14,14,13,13,13,12,12,12,11,11,11,10,10,10,
+  9,9,9,8,8,8,7,7,7,6,6,6,5,5,5,4,4,4,3,3,3,2,2,2,1,1,1,
+  0,SND_HOLD,
+  // dive
+  3,SND_HOLD,
+};
+
+// offsets of each bend script in SND_BENDS
+#define BEND_SHOT	0
+#define BEND_BOOM	2
+#define BEND_PLAYER_BOOM 11
+#define BEND_DIVE	20
+
+const signed char SND_BENDS[] = {
+  // shot: falls as the missile climbs
+  4,SND_LOOP,
+  // boom: drops once, 4 frames in
+  0,0,0,0,4,0,0,0,SND_LOOP,
+  // player boom: slowly lower noise
+  0,0,0,0,0,0,0,1,SND_LOOP,
+  // dive: falls as the attacker dives
+  1,SND_LOOP,
+};
+
+const SndDef SND_DEFS[] = {
+  { SND_V_PULSE1, 2, DUTY_50, 46,  73,     VOL_SHOT, BEND_SHOT },
+  { SND_V_NOISE,  3, 0,       12,  9,      VOL_BOOM, BEND_BOOM },
+  { SND_V_NOISE,  4, 0,       48,  9,      VOL_PLAYER_BOOM, BEND_PLAYER_BOOM },
+  { SND_V_PULSE1, 1, DUTY_12, 180, 0x140,  VOL_DIVE, BEND_DIVE },
+};
 
 void init_stars() {
-  byte oamid = 0; // 32 slots = 128 bytes
+  byte oamid = OAM_STARS; // 32 slots = 128 bytes
   byte i;
   for (i=0; i<32; i++) {
-    oamid = oam_spr(rand(), i*8, 103+(i&3), 0|OAM_BEHIND, oamid);
+    oamid = oam_spr(rand8(), i*8, 103+(i&3), 0|OAM_BEHIND, oamid);
   }
 }
 /*
 void draw_stars_c() {
   byte i;
-  for (i=0; i<32; i++) {
+  for (i=32; i<64; i++) {
     ++OAMBUF[i].y;
   }
 }
@@ -701,9 +1033,9 @@ void draw_stars_c() {
 void draw_stars() {
   asm("ldy #0");	// start with Y = 0
   asm("clc");		// clear carry for addition
-  asm("@1: lda $200,y");// read from OAM buffer
+  asm("@1: lda $280,y");// read from OAM buffer (stars)
   asm("adc #1");	// increment
-  asm("sta $200,y");	// write to OAM buffer
+  asm("sta $280,y");	// write to OAM buffer
   asm("iny");		// increment Y by 4
   asm("iny");
   asm("iny");
@@ -711,11 +1043,46 @@ void draw_stars() {
   asm("bpl @1");	// branch while < 128
 }
 
+// pad 0 this frame
+byte player_pad;
+
+void update_player() {
+  if (player_exploding) {
+    if ((sched_frame & 7) == 1) {
+      animate_player_explosion();
+      if (++player_exploding > 32 && enemies_left) {
+        new_player_ship();
+      }
+    }
+  } else {
+    if (sched_frame == 0 || enemies_left < 8) {
+      new_attack_wave();
+    }
+    move_player(player_pad);
+  }
+}
+
+// the round's work, in order; costs in 64ths of a frame
+const SchedTask ROUND_TASKS[] = {
+  // run                        period phase cost optional
+  { update_player,               1, 0, 2, 0 },
+  { move_attackers,              1, 0, 6, 0 },
+  { move_missiles,               1, 0, 2, 0 },
+  { collide,                     1, 0, 4, 0 },	// unmeasured, see README
+  { draw_attackers,              1, 0, 3, 0 },
+  { think_attackers,             2, 0, 1, 0 },
+  { animate_enemy_explosion,     4, 1, 1, 0 },
+  { draw_formation,              1, 0, 2, 0 },	// + COST_DRAW_ROW per row
+  { flap_formation,             16, 5, 1, 0 },
+  { draw_hud,                    1, 0, 1, 0 },
+  // first to go when the frame is over budget
+  { draw_stars,                  4, 3, 1, 1 },
+};
+
 void play_round() {
   register byte framecount;
-  register byte t0;
   byte end_timer = 255;
-  add_score(0);
+  hud_reset(); // the screen was just cleared
   //putbytes(NTADR_A(0, 1), "PLAYER 1", 8);
   setup_formation();
   clrobjs();
@@ -723,50 +1090,21 @@ void play_round() {
   framecount = 0;
   new_player_ship();
   while (end_timer) {
-    if (player_exploding) {
-      if ((framecount & 7) == 1) {
-        animate_player_explosion();
-        if (++player_exploding > 32 && enemies_left) {
-          new_player_ship();
-        }
-      }
-    } else {
-      if (framecount == 0 || enemies_left < 8) {
-        new_attack_wave();
-      }
-      move_player();
-    }
-    move_attackers();
-    move_missiles();
-    if (framecount & 1)
-      does_player_shoot_formation();
-    else
-      does_player_shoot_attacker(); 
-    draw_attackers();
-    if ((framecount & 0xf) == 0) {
-      think_attackers();
-    } else {
-      switch (framecount & 3) {
-        case 1: animate_enemy_explosion(); // continue...
-        case 2: does_missile_hit_player(); break;
-        case 3: draw_stars(); break;
-      }
-      set_sounds();
-      if (!enemies_left) end_timer--;
-      draw_next_row();
-    }
+    // read every frame, so a replay stays in step
+    player_pad = replay_pad();
+    enemies_left = count_enemies();
+    sched_run(ROUND_TASKS, sizeof(ROUND_TASKS)/sizeof(SchedTask),
+              framecount);
+    if (!enemies_left) end_timer--;
+#ifdef DEBUG_TELEMETRY
+    tel_end();
+#endif
     vrambuf_flush();
-    copy_sprites();
-#ifdef DEBUG_FRAMERATE
-    putchar(t0 & 31, 27, CHAR(' '));
-    putchar(framecount & 31, 27, CHAR(' '));
+#ifdef DEBUG_TELEMETRY
+    tel_begin();
 #endif
+    copy_sprites();
     framecount++;
-    t0 = nesclock();
-#ifdef DEBUG_FRAMERATE
-    putchar(t0 & 31, 27, CHAR('C'));
-    putchar(framecount & 31, 27, CHAR('F'));
-#endif
   }
 }
 
@@ -774,47 +1112,108 @@ void play_round() {
 // functions after this point aren't called often
 #pragma codesize(100)
 
-void set_shifted_pattern(const byte* src, word dest, byte shift) {
-  static byte buf[16*3];
-  byte y;
-  for (y=0; y<16; y++) {
-    byte a = src[y];
-    byte b = src[y+32];
-    buf[y] = a>>shift;
-    buf[y+16] = b>>shift | a<<(8-shift);
-    buf[y+32] = b<<(8-shift);
+// write 1bpp tiles at the current VRAM address,
+// with a zero second plane (rendering must be off)
+void vram_write_1bpp(register const byte* src, byte count) {
+  register byte i;
+  do {
+    for (i=0; i<8; i++) PPU.vram.data = src[i];
+    for (i=0; i<8; i++) PPU.vram.data = 0;
+    src += 8;
+  } while (--count);
+}
+
+// unpack a pattern table from chr.h, starting at tile first
+void upload_chr(word addr, const byte* font, byte nfont,
+                const byte* rle) {
+  vram_adr(addr);
+  if (nfont) vram_write_1bpp(font, nfont);
+  vram_unrle(rle); // continues at the next tile
+}
+
+// NMI callback: VRAM updates first, while still in vblank,
+// then music, then effects on top of it
+void __fastcall__ game_nmi(void) {
+#ifdef FORMATION_IRQ
+  // IRQs come here too, with bit 7 of A set
+  if (__A__ & 0x80) {
+    band_irq();
+    return;
   }
-  vram_adr(dest);
-  vram_write(buf, sizeof(buf));
+#endif
+  vrambuf_nmi();
+  chrq_nmi();
+#ifdef FORMATION_IRQ
+  // the music can run past the first split, so let the
+  // splits interrupt it
+  band_nmi();
+  asm("cli");
+#endif
+  famitone_update();
+  snd_update();
 }
 
 void setup_graphics() {
-  byte i;
-  word src;
-  word dest;
-  // copy background
+#ifdef FORMATION_IRQ
+  band_init(); // maps the CHR RAM
+#endif
+  // background and sprite pattern tables, already shifted
+  upload_chr(0x0000 + CHR0_FIRST*16, CHR0_1BPP, CHR0_1BPP_TILES, CHR0_RLE);
+  upload_chr(0x1000 + CHR1_FIRST*16, CHR1_1BPP, CHR1_1BPP_TILES, CHR1_RLE);
+  // first screen goes in while rendering is still off
+  screen_blast(&SCREEN_CLEAR, NAMETABLE_A);
   vram_adr(0x0);
-  vram_write(TILESET, sizeof(TILESET));
-  // copy sprites
-  vram_adr(0x1000);
-  vram_write(TILESET, sizeof(TILESET));
-  // write shifted versions of formation ships
-  src = SSRC_FORM1*16;
-  dest = SDST_FORM1*16;
-  for (i=0; i<8; i++) {
-    if (i==4) src += 16;
-    set_shifted_pattern(&TILESET[src], dest, i);
-    dest += 3*16;
-  }
-  // activate vram buffer
+  // activate vram buffer (drained by our NMI callback)
   vrambuf_clear();
-  set_vram_update(updbuf);
+  nmi_set_callback(game_nmi);
+  ppu_on_all();
 }
 
+#ifdef RECORD_REPLAY
+// recorded input, copy it out of RAM with the debugger
+byte replay_buf[256];
+#endif
+
+#ifdef PLAY_DEMO
+// input played at boot, then the pad takes over
+const byte DEMO_LOG[] = {
+  REPLAY_SEED & 0xff, REPLAY_SEED >> 8,
+  120, 0,
+  40, PAD_RIGHT,
+  1, PAD_RIGHT|PAD_A,
+  60, PAD_LEFT,
+  1, PAD_A,
+  90, PAD_LEFT,
+  1, PAD_A,
+  30, 0,
+  1, PAD_A,
+  120, PAD_RIGHT,
+  1, PAD_RIGHT|PAD_A,
+  80, PAD_LEFT,
+  1, PAD_LEFT|PAD_A,
+  0
+};
+#endif
+
 void main() {  
-  setup_graphics();
+#if defined(RECORD_REPLAY)
+  replay_record(REPLAY_SEED, replay_buf, sizeof(replay_buf));
+#elif defined(PLAY_DEMO)
+  replay_play(DEMO_LOG);
+#else
+  replay_live(REPLAY_SEED);
+#endif
+  // sound state is ready before the NMI callback goes in
   apu_init();
-  player_score = 0;
+  snd_init();
+  music_init();
+  setup_graphics();
+#ifdef DEBUG_TELEMETRY
+  tel_init(MASK_BG|MASK_SPR); // as set by ppu_on_all()
+#endif
+  music_play(0);
+  memset(player_score, 0, BCD_BYTES);
+  memset(high_score, 0, BCD_BYTES);
   while (1) {
     pal_all(PALETTE);
     oam_clear();
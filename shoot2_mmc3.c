@@ -0,0 +1,36 @@
+/*
+MMC3 (mapper 4) build of shoot2.c: the formation rows are
+drawn once and scrolled by scanline IRQ splits (see README).
+8bitworkshop reads //#link, NES_MAPPER and CFGFILE from the
+main file's text, without the preprocessor, so this file has
+its own; the game is shoot2.c, included below.
+*/
+
+#define FORMATION_IRQ
+
+#define NES_MAPPER 4	// mapper 4 (MMC3), for its scanline IRQ
+#define NES_CHR_BANKS 0	// CHR RAM
+
+// linker config: shoot2.cfg with the reset path in the fixed bank
+//#resource "shoot2_mmc3.cfg"
+#define CFGFILE shoot2_mmc3.cfg
+
+// the modules shoot2.c links
+//#link "apu.c"
+//#link "snd.c"
+//#link "music.s"
+//#link "replay.c"
+//#link "bcd.s"
+//#link "vrambuf.c"
+//#link "chrq.c"
+//#link "screen.c"
+//#link "sched.c"
+//#link "telemetry.c"
+//#link "hotzp.s"
+
+// formation rows scrolled by IRQ splits
+//#link "band.s"
+// MMC3 reset and vectors in the fixed bank
+//#link "mmc3.s"
+
+#include "shoot2.c"
@@ -0,0 +1,71 @@
+
+#include <string.h>
+#include "neslib.h"
+#include "apu.h"
+#include "snd.h"
+
+//#link "snd.s"
+
+// voice state, read by snd_update() (snd.s) in the NMI
+byte snd_timer[SND_VOICES];	// frames left, 0 = idle
+byte snd_id[SND_VOICES];	// effect playing
+byte snd_prio[SND_VOICES];	// its priority
+byte snd_ctrl[SND_VOICES];	// control register bits above the volume
+byte snd_vol_pos[SND_VOICES];	// offsets into SND_VOLS / SND_BENDS
+byte snd_bend_pos[SND_VOICES];
+byte snd_bend_start[SND_VOICES];
+byte snd_period_lo[SND_VOICES];
+byte snd_period_hi[SND_VOICES];
+byte snd_last_hi[SND_VOICES];	// high period we last wrote, $ff = none
+
+// silence all voices
+void snd_init(void) {
+  memset(snd_timer, 0, sizeof(snd_timer));
+  memset(snd_last_hi, 0xff, sizeof(snd_last_hi));
+}
+
+// start effect id; returns its voice, or 0xff if every
+// voice it can use is busy with something more important
+byte snd_play(byte id) {
+  register const SndDef* def = &SND_DEFS[id];
+  register byte v;
+  byte best = 0xff;
+  byte mask = 1;
+  byte prio = def->priority;
+  // an idle voice, or else the least important one we outrank
+  for (v=0; v<SND_VOICES; v++, mask <<= 1) {
+    if (!(def->voices & mask))
+      continue;
+    if (snd_timer[v] == 0) {
+      best = v;
+      break;
+    }
+    if (snd_prio[v] <= prio &&
+        (best == 0xff || snd_prio[v] < snd_prio[best]))
+      best = v;
+  }
+  if (best == 0xff)
+    return best;
+  v = best;
+  // idle the voice while we change it under the NMI
+  snd_timer[v] = 0;
+  snd_id[v] = id;
+  snd_prio[v] = prio;
+  snd_ctrl[v] = def->duty | (PULSE_CONSTVOL|PULSE_ENVLOOP);
+  snd_vol_pos[v] = def->vol;
+  snd_bend_pos[v] = snd_bend_start[v] = def->bend;
+  snd_period_lo[v] = def->period;
+  snd_period_hi[v] = def->period >> 8;
+  snd_last_hi[v] = 0xff; // restart the channel
+  snd_timer[v] = def->length;
+  return v;
+}
+
+// stop effect id wherever it is playing
+void snd_stop(byte id) {
+  register byte v;
+  for (v=0; v<SND_VOICES; v++) {
+    if (snd_id[v] == id)
+      snd_timer[v] = 0;
+  }
+}
@@ -0,0 +1,58 @@
+
+#ifndef _SND_H
+#define _SND_H
+
+#include "neslib.h"
+
+// Table-driven sound effects. snd_play() picks a voice from
+// the main loop; snd_update() runs the scripts from the NMI,
+// so sound keeps time on lag frames.
+
+// voices, one per APU channel (registers at $4000 + 4*voice)
+#define SND_PULSE0	0
+#define SND_PULSE1	1
+#define SND_TRIANGLE	2
+#define SND_NOISE	3
+#define SND_VOICES	4
+
+// voice masks for SndDef.voices
+#define SND_V_PULSE0	0x01
+#define SND_V_PULSE1	0x02
+#define SND_V_PULSE	(SND_V_PULSE0|SND_V_PULSE1)
+#define SND_V_TRIANGLE	0x04
+#define SND_V_NOISE	0x08
+
+// script markers
+#define SND_HOLD 0xff	// volume script: stay at the previous volume
+#define SND_LOOP 0x80	// bend script: start the script again
+
+// an effect (8 bytes)
+typedef struct {
+  byte voices;		// voices it may take (SND_V_*)
+  byte priority;	// takes voices playing at this priority or lower
+  byte duty;		// pulse duty (DUTY_*), 0 for triangle and noise
+  byte length;		// frames
+  word period;		// starting period (noise: 0-15)
+  byte vol;		// offset of its volume script in SND_VOLS
+  byte bend;		// offset of its bend script in SND_BENDS
+} SndDef;
+
+// defined by the game
+extern const SndDef SND_DEFS[];
+extern const byte SND_VOLS[];		// volume per frame, 0-15
+extern const signed char SND_BENDS[];	// period change per frame
+
+// silence all voices
+void snd_init(void);
+
+// start effect id; returns its voice, or 0xff if every
+// voice it can use is busy with something more important
+byte snd_play(byte id);
+
+// stop effect id wherever it is playing
+void snd_stop(byte id);
+
+// advance every voice one frame (call from the NMI)
+void __fastcall__ snd_update(void);
+
+#endif // snd.h
@@ -0,0 +1,134 @@
+;
+; Sound effect sequencer, run once per frame from the NMI.
+; See snd.h; the voice state is in snd.c.
+;
+; A voice costs ~27 cycles idle and ~180 playing, so 124
+; cycles with all four idle and up to 740 with all four
+; playing (JSR/RTS included, measured on a 6502 model).
+;
+; Runs after famitone_update, so a playing effect overrides
+; the music on its channel; idle voices don't touch the APU.
+; Writing a pulse's high period restarts its phase (a click).
+; FamiTone only writes it when the music's changes, which
+; shows in its record of the last write (ft_pulse_prev, from
+; music.s); we rewrite ours after that, or when it changes.
+; A steady effect over steady music writes it on neither
+; side. When an effect ends, its pulse goes back to the music
+; by spoiling that record. Triangle and noise have no phase
+; to keep and get it every frame.
+;
+
+.export _snd_update
+
+.import _SND_VOLS, _SND_BENDS
+.import _snd_timer, _snd_ctrl, _snd_vol_pos, _snd_bend_pos
+.import _snd_bend_start, _snd_period_lo, _snd_period_hi, _snd_last_hi
+.import ft_pulse_prev
+
+APU		= $4000		; voice n registers at APU+4*n
+TRIANGLE	= 2		; voice with no volume control
+
+.segment "BSS"
+
+vol:	.res 1
+music_hi: .res 2		; ft_pulse_prev when we last looked
+
+.segment "CODE"
+
+; void __fastcall__ snd_update(void);
+_snd_update:
+	ldx #3
+@voice:
+	lda _snd_timer,x
+	bne @playing
+	; idle: silence the channel once, then leave it
+	; alone (music may be using it)
+	sta vol
+	lda #$ff
+	cmp _snd_last_hi,x
+	bne @silence
+	jmp @next		; too far for beq
+@silence:
+	sta _snd_last_hi,x
+	cpx #TRIANGLE
+	bcs @write
+	sta ft_pulse_prev,x	; FamiTone rewrites its own next frame
+	bcc @write		; always
+@playing:
+	dec _snd_timer,x
+	; volume script: SND_HOLD after an entry keeps it
+	ldy _snd_vol_pos,x
+	lda _SND_VOLS+1,y
+	cmp #$ff
+	beq :+
+	inc _snd_vol_pos,x
+:	lda _SND_VOLS,y
+	sta vol
+	; bend script: SND_LOOP starts it again
+	ldy _snd_bend_pos,x
+	lda _SND_BENDS,y
+	cmp #$80
+	bne :+
+	lda _snd_bend_start,x
+	sta _snd_bend_pos,x
+	tay
+	lda _SND_BENDS,y
+:	inc _snd_bend_pos,x
+	; period += sign-extended bend
+	ldy #0
+	cmp #$80
+	bcc :+
+	dey
+:	clc
+	adc _snd_period_lo,x
+	sta _snd_period_lo,x
+	tya
+	adc _snd_period_hi,x
+	sta _snd_period_hi,x
+@write:
+	txa			; Y = register offset
+	asl
+	asl
+	tay
+	; control: duty/halt/constant volume | volume,
+	; or for the triangle, linear counter on or off
+	lda vol
+	cpx #TRIANGLE
+	bne @ctrl
+	cmp #1			; C = volume > 0
+	lda #$80
+	bcc @store
+	lda #$ff
+	bne @store		; always
+@ctrl:
+	ora _snd_ctrl,x
+@store:
+	sta APU,y
+	lda _snd_timer,x	; idle voices stop here
+	beq @next
+	lda _snd_period_lo,x
+	sta APU+2,y
+	cpx #TRIANGLE
+	bcs @always
+	; a pulse's high period: write it if the music wrote its
+	; own since we last looked, on a restart, or on a bend
+	lda ft_pulse_prev,x
+	cmp music_hi,x
+	sta music_hi,x
+	bne @always
+	lda _snd_period_hi,x
+	cmp _snd_last_hi,x
+	beq @next
+	bne @hi			; always
+@always:
+	lda _snd_period_hi,x
+@hi:
+	sta _snd_last_hi,x
+	ora #$08		; length counter load (halted anyway)
+	sta APU+3,y
+@next:
+	dex
+	bmi @done
+	jmp @voice		; too far for bpl
+@done:
+	rts
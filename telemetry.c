@@ -0,0 +1,83 @@
+
+#include <string.h>
+#include "neslib.h"
+#include "vrambuf.h"
+#include "telemetry.h"
+
+// at a fixed address, see shoot2.cfg
+#pragma bss-name (push, "TELEMETRY")
+byte tel_cost[TEL_FRAMES];
+#pragma bss-name (pop)
+
+byte tel_pos;
+word tel_lag;
+
+static byte normal_mask;	// PPU mask outside the logic
+static byte ntsc;		// nonzero on NTSC
+static byte wait_clock;		// nesclock() after the last wait
+static byte skip;		// vblanks toward the next NTSC frameskip
+static word full_64;		// idle spins in 1/64 of a frame
+static word idle;		// idle spins in the last wait
+static byte lag;		// vblanks the logic overran before it
+
+// wait for the next vblank, counting idle spins
+static word spin(void) {
+  register word n = 0;
+  byte t = nesclock();
+  do {
+    ++n;
+  } while (nesclock() == t);
+  return n;
+}
+
+// vrambuf_flush()'s wait: ppu_wait_frame(), timed
+static void wait_frame(void) {
+  byte now = nesclock();
+  // vblanks since the last wait are lag frames
+  lag = now - wait_clock;
+  idle = spin();
+  // like ppu_wait_frame(), skip one vblank in 6 on NTSC
+  // so the game runs at 50 frames a second
+  if (ntsc) {
+    skip += (byte)(nesclock() - wait_clock);
+    if (skip >= 6) {
+      skip -= 6;
+      spin();
+    }
+  }
+  wait_clock = nesclock();
+}
+
+void tel_init(byte mask) {
+  normal_mask = mask;
+  ntsc = ppu_system();
+  memset(tel_cost, 0, sizeof(tel_cost));
+  tel_pos = 0;
+  tel_lag = 0;
+  skip = 0;
+  lag = 0;
+  // time a whole idle frame
+  spin();
+  full_64 = (spin() >> 6) + 1;
+  idle = full_64 << 6;
+  vrambuf_wait = wait_frame;
+  wait_clock = nesclock();
+}
+
+void tel_begin(void) {
+  word spins = idle / full_64;
+  byte cost = spins < 64 ? 64 - (byte)spins : 0;
+  ppu_mask(normal_mask | TEL_MASK_TINT);
+  // logic time of the frame that just ended
+  tel_lag += lag;
+  if (lag > 2)
+    cost = 255;
+  else
+    cost += lag << 6;
+  tel_cost[tel_pos] = cost;
+  tel_pos = (tel_pos + 1) & (TEL_FRAMES-1);
+}
+
+void tel_end(void) {
+  ppu_mask(normal_mask);
+}
@@ -0,0 +1,38 @@
+
+#ifndef _TELEMETRY_H
+#define _TELEMETRY_H
+
+#include "neslib.h"
+
+// Frame telemetry: a raster bar tinting the screen while the
+// game logic runs, a lag-frame counter, and the cost of the
+// last TEL_FRAMES frames in RAM for an emulator's memory viewer.
+
+#define TEL_FRAMES 64
+
+// tel_cost[] is at this address (TELEMETRY segment, shoot2.cfg)
+#define TEL_COST_ADDR 0x7c0
+
+// logic time per frame, in 64ths of a frame (64 = the whole
+// frame), plus 64 for each lag frame; tel_pos is the next slot
+extern byte tel_cost[TEL_FRAMES];
+extern byte tel_pos;
+
+// frames the logic overran since tel_init()
+extern word tel_lag;
+
+// PPU mask while the logic runs
+#define TEL_MASK_TINT (MASK_TINT_RED|MASK_TINT_BLUE)
+
+// time an idle frame and take over vrambuf_flush()'s wait;
+// mask is the PPU mask outside the logic
+void tel_init(byte mask);
+
+// game logic starts (after vrambuf_flush): tint the screen
+// and log the frame that just ended
+void tel_begin(void);
+
+// game logic ends (before vrambuf_flush): restore the mask
+void tel_end(void);
+
+#endif // telemetry.h
@@ -0,0 +1,293 @@
+#!/usr/bin/env python3
+"""
+Pattern table generator for CHR RAM.
+
+Reads the TILESET array from tileset.h (16 bytes per tile, two
+bitplanes) and writes chr.h with the final contents of each pattern
+table, ready for a straight copy at boot:
+
+  --table T=RANGES   tiles copied into table T (0 = $0000, 1 = $1000),
+                     e.g. 0=0-63,68-127; other tiles are left out
+  --shift T:SRC:DST  the 8 pre-shifted phases of the formation enemy
+                     at SRC, placed in table T from tile DST; tiles
+                     identical to one already in the table are reused
+  --flap             every phase starts on animation frame 0 (SRC,
+                     SRC+2), and the tiles that differ in frame 1
+                     (SRC+1, SRC+3) get a run of their own per phase,
+                     to be streamed into CHR RAM at run time
+
+For each table, chr.h has CHR<T>_FIRST (first tile uploaded), the
+leading run of tiles with an empty second plane stored as plane 0
+only (CHR<T>_1BPP, CHR<T>_1BPP_TILES), and the rest packed for
+neslib's vram_unrle() (CHR<T>_RLE). The tile names of each shifted
+phase go in CHR_PHASE0/1/2[8], and the free tiles are listed in a
+comment. With --flap, CHR_FLAP0/1 hold the streamed tiles in both
+frames, and CHR_FLAP_FIRST/COUNT[8] give each phase's run, with its
+place in CHR_FLAP0/1 in CHR_FLAP_DATA[8] (shared tiles allocated
+between two runs leave a gap in the table but not in the data).
+
+    python3 tools/mkchr.py --table 0=0-63,68-127 --table 1=102-105 \
+        --shift 0:64:128 --flap tileset.h chr.h
+"""
+
+import argparse
+import re
+import sys
+
+TILE = 16
+
+
+def read_tileset(path, name="TILESET"):
+    text = open(path).read()
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    text = re.sub(r"//[^\n]*", "", text)
+    m = re.search(r"\b%s\s*\[[^\]]*\]\s*=\s*\{(.*?)\}\s*;" % name, text, re.S)
+    if not m:
+        sys.exit("%s: no %s array" % (path, name))
+    data = bytes(int(v, 0) for v in re.findall(r"0[xX][0-9A-Fa-f]+|\d+",
+                                                m.group(1)))
+    if len(data) % TILE:
+        sys.exit("%s: %s is not a whole number of tiles" % (path, name))
+    return data
+
+
+def is_1bpp(tile):
+    return not any(tile[8:16])
+
+
+def rle_encode(data):
+    """Pack for neslib vram_unrle(): a tag byte, then literals; the tag
+    followed by n repeats the previous byte n times; tag, 0 ends."""
+    counts = [0] * 256
+    for b in data:
+        counts[b] += 1
+    tag = min(range(256), key=lambda b: (counts[b], b))
+    out = bytearray([tag])
+    i = 0
+    while i < len(data):
+        b = data[i]
+        run = 1
+        while i + run < len(data) and data[i + run] == b:
+            run += 1
+        # the tag can't be a literal; it is the least used value,
+        # so this only fails when all 256 values appear
+        if b == tag:
+            sys.exit("rle: no free tag byte")
+        # the first byte of a run is always a literal
+        out.append(b)
+        rest = run - 1
+        while rest >= 2:
+            n = min(rest, 255)
+            out += bytes([tag, n])
+            rest -= n
+        if rest:
+            out.append(b)
+        i += run
+    out += bytes([tag, 0])
+    return bytes(out)
+
+
+def rle_decode(packed):
+    tag = packed[0]
+    out = bytearray()
+    i = 1
+    while True:
+        b = packed[i]
+        i += 1
+        if b != tag:
+            out.append(b)
+            continue
+        n = packed[i]
+        i += 1
+        if n == 0:
+            return bytes(out)
+        out += bytes([out[-1]]) * n
+
+
+def shift_phase(a, b, shift):
+    """Three tiles of the 16-pixel row pair (a, b) shifted right,
+    as set_shifted_pattern() used to do in CHR RAM."""
+    l = bytes(x >> shift for x in a)
+    m = bytes(((y >> shift) | (x << (8 - shift))) & 0xff for x, y in zip(a, b))
+    r = bytes((y << (8 - shift)) & 0xff for y in b)
+    return [l, m, r]
+
+
+def parse_ranges(spec):
+    tiles = []
+    for part in spec.split(","):
+        lo, _, hi = part.partition("-")
+        tiles += range(int(lo, 0), int(hi or lo, 0) + 1)
+    return tiles
+
+
+def free_ranges(table):
+    out = []
+    i = 0
+    while i < 256:
+        if table[i] is None:
+            j = i
+            while j + 1 < 256 and table[j + 1] is None:
+                j += 1
+            out.append("%d" % i if i == j else "%d-%d" % (i, j))
+            i = j + 1
+        else:
+            i += 1
+    return ",".join(out) or "none"
+
+
+def c_array(name, data, comment):
+    lines = ["// " + comment,
+             "const byte %s[%d] = {" % (name, len(data))]
+    for i in range(0, len(data), 16):
+        lines.append("  " + ",".join("0x%02X" % b for b in data[i:i+16]) + ",")
+    lines.append("};")
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    ap = argparse.ArgumentParser(description="build CHR RAM pattern tables")
+    ap.add_argument("input", help="tileset.h")
+    ap.add_argument("output", help="chr.h")
+    ap.add_argument("--table", action="append", default=[],
+                    metavar="T=RANGES", help="tiles to put in table T")
+    ap.add_argument("--shift", metavar="T:SRC:DST",
+                    help="pre-shifted formation phases")
+    ap.add_argument("--flap", action="store_true",
+                    help="stream the second animation frame")
+    args = ap.parse_args()
+
+    chr = read_tileset(args.input)
+    tiles = [chr[i*TILE:(i+1)*TILE] for i in range(len(chr) // TILE)]
+    tables = [[None] * 256, [None] * 256]
+
+    for spec in args.table:
+        t, _, ranges = spec.partition("=")
+        for n in parse_ranges(ranges):
+            tables[int(t)][n] = tiles[n]
+
+    phases = None
+    flap = None
+    if args.shift:
+        t, src, dst = (int(v, 0) for v in args.shift.split(":"))
+        table = tables[t]
+        phases = [[], [], []]
+        if args.flap:
+            flap = {"table": t, "first": [], "count": [], "data": [],
+                    "frames": [[], []]}
+        for i in range(8):
+            if args.flap:
+                shifted = shift_phase(tiles[src], tiles[src + 2], i)
+                other = shift_phase(tiles[src + 1], tiles[src + 3], i)
+            else:
+                # phases 4-7 use the second animation frame
+                a = tiles[src + (i >= 4)]
+                b = tiles[src + 2 + (i >= 4)]
+                shifted = other = shift_phase(a, b, i)
+            names = [None] * 3
+            # tiles the same in both frames can be shared
+            for k, tile in enumerate(shifted):
+                if tile != other[k]:
+                    continue
+                if tile in table:
+                    n = table.index(tile)
+                else:
+                    while table[dst] is not None:
+                        dst += 1
+                    n = dst
+                    table[n] = tile
+                names[k] = n
+            # the rest are this phase's run, in one upload
+            run = []
+            if flap is not None:
+                flap["data"].append(len(flap["frames"][0]))
+            for k, tile in enumerate(shifted):
+                if names[k] is not None:
+                    continue
+                while table[dst] is not None:
+                    dst += 1
+                if run and dst != run[-1] + 1:
+                    sys.exit("--flap: phase %d run is not contiguous" % i)
+                names[k] = dst
+                table[dst] = tile
+                run.append(dst)
+                flap["frames"][0].append(tile)
+                flap["frames"][1].append(other[k])
+            if flap is not None:
+                if not run:
+                    flap["data"][-1] = 0
+                flap["first"].append(run[0] if run else 0)
+                flap["count"].append(len(run))
+            for k in range(3):
+                phases[k].append(names[k])
+
+    out = ["",
+           "// generated by tools/mkchr.py from %s, do not edit" % args.input,
+           ""]
+    body = []
+    total = 0
+    for t, table in enumerate(tables):
+        used = [n for n in range(256) if table[n] is not None]
+        out.append("// table %d free tiles: %s" % (t, free_ranges(table)))
+        if not used:
+            continue
+        first, last = used[0], used[-1]
+        blank = bytes(TILE)
+        data = [table[n] or blank for n in range(first, last + 1)]
+        n1 = 0
+        while n1 < len(data) and is_1bpp(data[n1]):
+            n1 += 1
+        plane0 = b"".join(d[:8] for d in data[:n1])
+        rest = b"".join(data[n1:])
+        body.append("#define CHR%d_FIRST %d" % (t, first))
+        body.append("#define CHR%d_1BPP_TILES %d" % (t, n1))
+        if n1:
+            body.append(c_array("CHR%d_1BPP" % t, plane0,
+                                "tiles %d..%d, plane 0 only (plane 1 is zero)"
+                                % (first, first + n1 - 1)))
+        else:
+            body.append("#define CHR%d_1BPP NULL\n" % t)
+        packed = rle_encode(rest) if rest else bytes([0, 0])
+        assert rle_decode(packed) == rest
+        body.append(c_array("CHR%d_RLE" % t, packed,
+                            "tiles %d..%d, vram_unrle() format"
+                            % (first + n1, last)))
+        total += len(plane0) + len(packed)
+    out.append("// %d bytes packed" % total)
+    out.append("")
+    out += body
+    if phases:
+        out.append("// formation tile names for each pixel phase "
+                   "(left, middle, right)")
+        for k in range(3):
+            out.append("const byte CHR_PHASE%d[8] = { %s };" %
+                       (k, ", ".join(str(n) for n in phases[k])))
+        out.append("")
+    if flap:
+        t = flap["table"]
+        first = min(n for n, c in zip(flap["first"], flap["count"]) if c)
+        out.append("// streamed formation tiles: each phase's run starts "
+                   "CHR_FLAP_FIRST")
+        out.append("// tiles after CHR_FLAP_ADDR (table %d, tile %d), "
+                   "and the data is in" % (t, first))
+        out.append("// CHR_FLAP0 (as uploaded) and CHR_FLAP1 from "
+                   "16*CHR_FLAP_DATA")
+        out.append("#define CHR_FLAP_ADDR 0x%04X" % (t*0x1000 + first*TILE))
+        out.append("#define CHR_FLAP_TILES %d" % len(flap["frames"][0]))
+        for name in ("first", "count", "data"):
+            vals = [(n - first if c else 0) if name == "first" else
+                    d if name == "data" else c
+                    for n, c, d in zip(flap["first"], flap["count"],
+                                       flap["data"])]
+            out.append("const byte CHR_FLAP_%s[8] = { %s };" %
+                       (name.upper(), ", ".join(str(v) for v in vals)))
+        out.append("")
+        for f in range(2):
+            out.append(c_array("CHR_FLAP%d" % f, b"".join(flap["frames"][f]),
+                               "wing-flap frame %d" % f))
+    with open(args.output, "w") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
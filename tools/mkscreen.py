@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""
+Screen packer for screen.c.
+
+Packs full nametables (960 names + 64 attribute bytes) for neslib's
+vram_unrle() and writes a C header with one Screen per input, each
+declaring its own cost:
+
+  size          packed bytes in ROM
+  blast_cycles  CPU cycles for vram_unrle() with rendering off
+  frames        vblanks to stream it at SCREEN_CHUNK bytes per frame
+
+An input is a 1024-byte .nam file (e.g. from NES Screen Tool), or
+fill:N for a screen of tile N with attribute 0.
+
+    python3 tools/mkscreen.py -o screens.h SCREEN_CLEAR=fill:0
+"""
+
+import argparse
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from mkchr import rle_encode, rle_decode, c_array  # noqa: E402
+
+NAMETABLE = 1024
+
+# vram_unrle() cycles, counted from neslib's loop
+CYCLES_SETUP = 40	# call, tag fetch
+CYCLES_LITERAL = 25	# fetch, compare, store
+CYCLES_RUN = 30		# tag + count fetch, loop setup
+CYCLES_REPEAT = 9	# sta/dex/bne per repeated byte
+
+
+def load(spec):
+    if spec.startswith("fill:"):
+        return bytes([int(spec[5:], 0)]) * 960 + bytes(64)
+    data = open(spec, "rb").read()
+    if len(data) != NAMETABLE:
+        sys.exit("%s: expected %d bytes, got %d" % (spec, NAMETABLE, len(data)))
+    return data
+
+
+def blast_cycles(packed):
+    tag = packed[0]
+    cycles = CYCLES_SETUP
+    i = 1
+    while True:
+        b = packed[i]
+        i += 1
+        if b != tag:
+            cycles += CYCLES_LITERAL
+            continue
+        n = packed[i]
+        i += 1
+        if n == 0:
+            return cycles
+        cycles += CYCLES_RUN + CYCLES_REPEAT * n
+
+
+def main():
+    ap = argparse.ArgumentParser(description="pack nametables for screen.c")
+    ap.add_argument("screens", nargs="+", metavar="NAME=FILE|fill:N")
+    ap.add_argument("-o", "--output", required=True)
+    ap.add_argument("--chunk", type=int, default=32,
+                    help="SCREEN_CHUNK in screen.h (default 32)")
+    args = ap.parse_args()
+
+    out = ["",
+           "// generated by tools/mkscreen.py, do not edit",
+           "",
+           '#include "screen.h"',
+           ""]
+    for spec in args.screens:
+        name, _, src = spec.partition("=")
+        data = load(src)
+        packed = rle_encode(data)
+        assert rle_decode(packed) == data
+        frames = (NAMETABLE + args.chunk - 1) // args.chunk
+        out.append(c_array(name + "_RLE", packed, "%s, %d bytes" %
+                           (os.path.basename(src), NAMETABLE)))
+        out.append("const Screen %s = { %s_RLE, %d, %d, %d };" %
+                   (name, name, len(packed), blast_cycles(packed), frames))
+        out.append("")
+    with open(args.output, "w") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
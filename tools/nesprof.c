@@ -0,0 +1,1008 @@
+/*
+Headless cycle-counting profiler for the NES build of shoot2.c.
+
+Boots an iNES image (mapper 0 or 2, CHR RAM) on a 6502 core with
+exact instruction timing and a PPU frame-timing model, then reports:
+
+- a flat per-function profile (self and inclusive cycles),
+- a per-frame histogram of busy CPU cycles against the NTSC budget,
+- the worst frames and the functions that dominated them,
+- the longest single call of each function, checked against
+  per-function cycle caps given with -x.
+
+Function names come from the cc65 label file (ld65 -Ln shoot2.lbl)
+or the exports section of the map file (ld65 -m shoot2.map).
+Without symbols, cycles are reported against raw addresses.
+
+Build and run on the host:
+
+  cc -O2 -o nesprof tools/nesprof.c
+  ./nesprof -l shoot2.lbl -n 1200 bin/shoot2.c.rom
+  ./nesprof -l shoot2.lbl -x _famitone_update=2500 bin/shoot2.c.rom
+
+A frame is the span between two NMIs. "Busy" cycles exclude time
+spent in idle wait loops: the symbols named with -w (default
+_ppu_wait_frame, _ppu_wait_nmi) and, when no symbol matches, any
+store-free backward branch loop of at most 6 bytes.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+typedef uint8_t byte;
+typedef uint16_t word;
+
+#define NTSC_DOTS_PER_LINE	341
+#define NTSC_LINES		262
+#define NTSC_VBLANK_LINE	241
+#define NTSC_FRAME_CYCLES	29780	// 262*341/3, rounded down
+
+#define MAX_FRAMES		65536
+#define MAX_SYMS		4096
+#define MAX_DEPTH		256
+#define TOP_PER_FRAME		4
+#define MAX_CAPS		8
+
+/// ROM / mapper
+
+static byte* prg;		// PRG ROM image
+static int prg_banks;		// number of 16 KB banks
+static int mapper;
+static byte prg_bank;		// UxROM switchable bank
+static byte ram[0x800];
+static byte wram[0x2000];
+
+/// PPU state (timing and VRAM writes only, nothing is rendered)
+
+static byte ppu_ctrl;
+static byte ppu_mask;
+static byte ppu_status;
+static byte ppu_w;
+static word ppu_addr;
+static byte vram[0x4000];
+static long ppu_dot;		// dot within frame, 0..89341
+static int nmi_pending;
+
+/// controller
+
+static byte pad_state;
+static byte pad_shift;
+static byte pad_strobe;
+
+/// CPU
+
+static word pc;
+static byte a, x, y, s, p;
+static unsigned long long cycles;
+static int extra;		// DMA stall and page-cross cycles
+
+#define FLAG_C 0x01
+#define FLAG_Z 0x02
+#define FLAG_I 0x04
+#define FLAG_D 0x08
+#define FLAG_B 0x10
+#define FLAG_U 0x20
+#define FLAG_V 0x40
+#define FLAG_N 0x80
+
+/// symbols and profile
+
+typedef struct {
+  word addr;
+  char* name;
+  unsigned long long self;
+  unsigned long long incl;
+  unsigned long max_call;	// longest single call (inclusive)
+  unsigned long frame_self;	// self cycles in the current frame
+  int active;			// nesting depth on the shadow stack
+  int idle;			// counts as idle time
+} Symbol;
+
+static Symbol syms[MAX_SYMS];
+static int nsyms;
+static short sym_of_addr[0x10000];	// symbol index per PRG address, -1 if none
+static Symbol unknown_sym = { .name = "[unknown]" };
+static Symbol nmi_sym = { .name = "[nmi]" };
+
+typedef struct {
+  Symbol* sym;
+  byte s_after;			// stack pointer after the call pushed
+  unsigned long long start;
+} Frame;
+
+static Frame shadow[MAX_DEPTH];
+static int depth;
+
+// -x name=cycles
+typedef struct {
+  const char* name;
+  unsigned long cycles;
+} Cap;
+
+static Cap caps[MAX_CAPS];
+static int ncaps;
+
+typedef struct {
+  unsigned long total;		// cycles between NMIs
+  unsigned long busy;		// total minus idle loops
+  unsigned long nmi;		// cycles in the NMI handler
+  unsigned vram_vblank;		// $2007 writes during vblank
+  unsigned vram_render;		// $2007 writes with rendering on
+  Symbol* top[TOP_PER_FRAME];
+  unsigned long top_cycles[TOP_PER_FRAME];
+} FrameStat;
+
+static FrameStat* frames;
+static int nframes;
+static FrameStat cur;
+static int in_nmi;
+static int nmi_depth;
+static unsigned long long nmi_start;
+static int skip_frames;
+static int idle_by_symbol;
+
+/// memory
+
+static byte pad_for_frame(int frame);
+
+static byte ppu_read(word reg) {
+  byte v = 0;
+  switch (reg & 7) {
+    case 2:
+      v = ppu_status;
+      ppu_status &= ~0x80;
+      ppu_w = 0;
+      break;
+    case 7:
+      v = vram[ppu_addr & 0x3fff];
+      ppu_addr += (ppu_ctrl & 4) ? 32 : 1;
+      break;
+  }
+  return v;
+}
+
+static int in_vblank(void) {
+  return ppu_dot >= (long)NTSC_VBLANK_LINE*NTSC_DOTS_PER_LINE;
+}
+
+static void ppu_write(word reg, byte v) {
+  switch (reg & 7) {
+    case 0:
+      // enabling NMI during vblank fires it immediately
+      if (!(ppu_ctrl & 0x80) && (v & 0x80) && (ppu_status & 0x80))
+        nmi_pending = 1;
+      ppu_ctrl = v;
+      break;
+    case 1:
+      ppu_mask = v;
+      break;
+    case 5:
+      ppu_w ^= 1;
+      break;
+    case 6:
+      if (!ppu_w)
+        ppu_addr = (ppu_addr & 0xff) | ((v & 0x3f) << 8);
+      else
+        ppu_addr = (ppu_addr & 0xff00) | v;
+      ppu_w ^= 1;
+      break;
+    case 7:
+      vram[ppu_addr & 0x3fff] = v;
+      ppu_addr += (ppu_ctrl & 4) ? 32 : 1;
+      if (in_vblank())
+        cur.vram_vblank++;
+      else if (ppu_mask & 0x18)
+        cur.vram_render++;
+      break;
+  }
+}
+
+static byte rd(word addr) {
+  if (addr < 0x2000)
+    return ram[addr & 0x7ff];
+  if (addr < 0x4000)
+    return ppu_read(addr);
+  if (addr == 0x4016) {
+    byte v = pad_shift & 1;
+    if (!pad_strobe)
+      pad_shift = (pad_shift >> 1) | 0x80;
+    return v | 0x40;
+  }
+  if (addr < 0x6000)
+    return 0x40;
+  if (addr < 0x8000)
+    return wram[addr & 0x1fff];
+  if (mapper == 2 && addr < 0xc000)
+    return prg[(prg_bank % prg_banks) * 0x4000 + (addr & 0x3fff)];
+  if (mapper == 2)
+    return prg[(prg_banks-1) * 0x4000 + (addr & 0x3fff)];
+  return prg[(addr - 0x8000) % (prg_banks * 0x4000)];
+}
+
+static void wr(word addr, byte v) {
+  if (addr < 0x2000) {
+    ram[addr & 0x7ff] = v;
+  } else if (addr < 0x4000) {
+    ppu_write(addr, v);
+  } else if (addr == 0x4014) {
+    // OAM DMA stalls the CPU for 513 or 514 cycles
+    extra += 513 + (int)(cycles & 1);
+  } else if (addr == 0x4016) {
+    // latch the buttons; reads shift them out once strobe is low
+    pad_strobe = v & 1;
+    pad_shift = pad_state;
+  } else if (addr >= 0x6000 && addr < 0x8000) {
+    wram[addr & 0x1fff] = v;
+  } else if (addr >= 0x8000) {
+    if (mapper == 2)
+      prg_bank = v;
+  }
+}
+
+static word rd16(word addr) {
+  return rd(addr) | (rd(addr+1) << 8);
+}
+
+/// profile bookkeeping
+
+static Symbol* symbol_at(word addr) {
+  short i = sym_of_addr[addr];
+  return i < 0 ? &unknown_sym : &syms[i];
+}
+
+static void enter(Symbol* sym) {
+  if (depth == MAX_DEPTH)
+    return;
+  shadow[depth].sym = sym;
+  shadow[depth].s_after = s;
+  shadow[depth].start = cycles;
+  sym->active++;
+  depth++;
+}
+
+static void leave(void) {
+  // pop every call whose frame lies below the current stack pointer,
+  // which also recovers from tail calls and stack tricks
+  while (depth > 0 && shadow[depth-1].s_after < s) {
+    Frame* f = &shadow[--depth];
+    if (--f->sym->active == 0) {
+      unsigned long d = cycles - f->start;
+      f->sym->incl += d;
+      if (d > f->sym->max_call)
+        f->sym->max_call = d;
+    }
+  }
+}
+
+static void push(byte v) {
+  wr(0x100 + s, v);
+  s--;
+}
+
+static byte pull(void) {
+  s++;
+  return rd(0x100 + s);
+}
+
+static void interrupt(word vector, int brk) {
+  push((pc >> 8) & 0xff);
+  push(pc & 0xff);
+  push((p | FLAG_U | (brk ? FLAG_B : 0)) & 0xff);
+  p |= FLAG_I;
+  pc = rd16(vector);
+  cycles += 7;
+}
+
+/// frames
+
+static void keep_top(Symbol* sym) {
+  int i, j;
+  for (i=0; i<TOP_PER_FRAME; i++) {
+    if (!cur.top[i] || sym->frame_self > cur.top_cycles[i]) {
+      for (j=TOP_PER_FRAME-1; j>i; j--) {
+        cur.top[j] = cur.top[j-1];
+        cur.top_cycles[j] = cur.top_cycles[j-1];
+      }
+      cur.top[i] = sym;
+      cur.top_cycles[i] = sym->frame_self;
+      return;
+    }
+  }
+}
+
+static void end_frame(void) {
+  int i;
+  memset(cur.top, 0, sizeof(cur.top));
+  for (i=0; i<nsyms; i++) {
+    if (syms[i].frame_self && !syms[i].idle)
+      keep_top(&syms[i]);
+    syms[i].frame_self = 0;
+  }
+  if (unknown_sym.frame_self)
+    keep_top(&unknown_sym);
+  unknown_sym.frame_self = 0;
+  if (nframes < MAX_FRAMES)
+    frames[nframes++] = cur;
+  // boot frames stay out of the flat profile
+  if (nframes == skip_frames) {
+    for (i=0; i<nsyms; i++) {
+      syms[i].self = syms[i].incl = 0;
+      syms[i].max_call = 0;
+    }
+    unknown_sym.self = unknown_sym.incl = nmi_sym.incl = 0;
+    nmi_sym.max_call = 0;
+  }
+  memset(&cur, 0, sizeof(cur));
+  pad_state = pad_for_frame(nframes);
+}
+
+/// idle detection
+
+static int is_store_free_loop(word from, word to) {
+  // opcodes that write memory (STA/STX/STY, INC/DEC/shifts on memory)
+  static const byte writes[] = {
+    0x81,0x84,0x85,0x86,0x8c,0x8d,0x8e,0x91,0x94,0x95,0x96,0x99,0x9d,
+    0x06,0x0e,0x16,0x1e,0x26,0x2e,0x36,0x3e,0x46,0x4e,0x56,0x5e,
+    0x66,0x6e,0x76,0x7e,0xc6,0xce,0xd6,0xde,0xe6,0xee,0xf6,0xfe,
+  };
+  word a;
+  unsigned i;
+  for (a=from; a<to; a++) {
+    byte op = rd(a);
+    for (i=0; i<sizeof(writes); i++)
+      if (op == writes[i])
+        return 0;
+  }
+  return 1;
+}
+
+static word spin_lo, spin_hi;	// current tight loop, if any
+
+/// CPU core
+
+#define SETNZ(v) p = (p & ~(FLAG_N|FLAG_Z)) | ((v) & 0x80) | ((v) ? 0 : FLAG_Z)
+
+static void adc(byte v) {
+  unsigned sum = a + v + (p & FLAG_C);
+  p &= ~(FLAG_C|FLAG_V);
+  if (sum > 0xff) p |= FLAG_C;
+  if (~(a ^ v) & (a ^ sum) & 0x80) p |= FLAG_V;
+  a = sum;
+  SETNZ(a);
+}
+
+static void cmp(byte r, byte v) {
+  unsigned d = r - v;
+  p &= ~FLAG_C;
+  if (r >= v) p |= FLAG_C;
+  SETNZ((byte)d);
+}
+
+// addressing modes, returning the effective address
+static word am_zp(void)  { return rd(pc++); }
+static word am_zpx(void) { return (rd(pc++) + x) & 0xff; }
+static word am_zpy(void) { return (rd(pc++) + y) & 0xff; }
+static word am_abs(void) { word v = rd16(pc); pc += 2; return v; }
+static word am_abx(int rdpen) {
+  word base = rd16(pc); word v = base + x; pc += 2;
+  if (rdpen && (base & 0xff00) != (v & 0xff00)) extra++;
+  return v;
+}
+static word am_aby(int rdpen) {
+  word base = rd16(pc); word v = base + y; pc += 2;
+  if (rdpen && (base & 0xff00) != (v & 0xff00)) extra++;
+  return v;
+}
+static word am_izx(void) {
+  byte z = rd(pc++) + x;
+  return rd(z) | (rd((byte)(z+1)) << 8);
+}
+static word am_izy(int rdpen) {
+  byte z = rd(pc++);
+  word base = rd(z) | (rd((byte)(z+1)) << 8);
+  word v = base + y;
+  if (rdpen && (base & 0xff00) != (v & 0xff00)) extra++;
+  return v;
+}
+
+static void branch(int cond) {
+  signed char off = (signed char) rd(pc++);
+  if (cond) {
+    word dest = pc + off;
+    extra += ((pc & 0xff00) != (dest & 0xff00)) ? 2 : 1;
+    if (off < 0 && off >= -8 && is_store_free_loop(dest, pc)) {
+      spin_lo = dest;
+      spin_hi = pc;
+    }
+    pc = dest;
+  }
+}
+
+// base cycle counts for all 256 opcodes (undocumented ones are fatal)
+static const byte CYCLES[256] = {
+  7,6,0,0,0,3,5,0,3,2,2,0,0,4,6,0, 2,5,0,0,0,4,6,0,2,4,0,0,0,4,7,0,
+  6,6,0,0,3,3,5,0,4,2,2,0,4,4,6,0, 2,5,0,0,0,4,6,0,2,4,0,0,0,4,7,0,
+  6,6,0,0,0,3,5,0,3,2,2,0,3,4,6,0, 2,5,0,0,0,4,6,0,2,4,0,0,0,4,7,0,
+  6,6,0,0,0,3,5,0,4,2,2,0,5,4,6,0, 2,5,0,0,0,4,6,0,2,4,0,0,0,4,7,0,
+  0,6,0,0,3,3,3,0,2,0,2,0,4,4,4,0, 2,6,0,0,4,4,4,0,2,5,2,0,0,5,0,0,
+  2,6,2,0,3,3,3,0,2,2,2,0,4,4,4,0, 2,5,0,0,4,4,4,0,2,4,2,0,4,4,4,0,
+  2,6,0,0,3,3,5,0,2,2,2,0,4,4,6,0, 2,5,0,0,0,4,6,0,2,4,0,0,0,4,7,0,
+  2,6,0,0,3,3,5,0,2,2,2,0,4,4,6,0, 2,5,0,0,0,4,6,0,2,4,0,0,0,4,7,0,
+};
+
+#define RMW(addr,op) { word ea = (addr); byte v = rd(ea); wr(ea, v); op; wr(ea, v); SETNZ(v); }
+#define ASL(v) p = (p & ~FLAG_C) | ((v) >> 7); v <<= 1
+#define LSR(v) p = (p & ~FLAG_C) | ((v) & 1); v >>= 1
+#define ROL(v) { byte c = p & FLAG_C; p = (p & ~FLAG_C) | ((v) >> 7); v = (v << 1) | c; }
+#define ROR(v) { byte c = p & FLAG_C; p = (p & ~FLAG_C) | ((v) & 1); v = (v >> 1) | (c << 7); }
+
+static int step(void) {
+  word opc = pc;
+  byte op = rd(pc++);
+  word ea;
+  byte v;
+  extra = 0;
+  if (!CYCLES[op]) {
+    fprintf(stderr, "illegal opcode $%02x at $%04x\n", op, opc);
+    return -1;
+  }
+  switch (op) {
+    // loads
+    case 0xa9: a = rd(pc++); SETNZ(a); break;
+    case 0xa5: a = rd(am_zp()); SETNZ(a); break;
+    case 0xb5: a = rd(am_zpx()); SETNZ(a); break;
+    case 0xad: a = rd(am_abs()); SETNZ(a); break;
+    case 0xbd: a = rd(am_abx(1)); SETNZ(a); break;
+    case 0xb9: a = rd(am_aby(1)); SETNZ(a); break;
+    case 0xa1: a = rd(am_izx()); SETNZ(a); break;
+    case 0xb1: a = rd(am_izy(1)); SETNZ(a); break;
+    case 0xa2: x = rd(pc++); SETNZ(x); break;
+    case 0xa6: x = rd(am_zp()); SETNZ(x); break;
+    case 0xb6: x = rd(am_zpy()); SETNZ(x); break;
+    case 0xae: x = rd(am_abs()); SETNZ(x); break;
+    case 0xbe: x = rd(am_aby(1)); SETNZ(x); break;
+    case 0xa0: y = rd(pc++); SETNZ(y); break;
+    case 0xa4: y = rd(am_zp()); SETNZ(y); break;
+    case 0xb4: y = rd(am_zpx()); SETNZ(y); break;
+    case 0xac: y = rd(am_abs()); SETNZ(y); break;
+    case 0xbc: y = rd(am_abx(1)); SETNZ(y); break;
+    // stores
+    case 0x85: wr(am_zp(), a); break;
+    case 0x95: wr(am_zpx(), a); break;
+    case 0x8d: wr(am_abs(), a); break;
+    case 0x9d: wr(am_abx(0), a); break;
+    case 0x99: wr(am_aby(0), a); break;
+    case 0x81: wr(am_izx(), a); break;
+    case 0x91: wr(am_izy(0), a); break;
+    case 0x86: wr(am_zp(), x); break;
+    case 0x96: wr(am_zpy(), x); break;
+    case 0x8e: wr(am_abs(), x); break;
+    case 0x84: wr(am_zp(), y); break;
+    case 0x94: wr(am_zpx(), y); break;
+    case 0x8c: wr(am_abs(), y); break;
+    // transfers
+    case 0xaa: x = a; SETNZ(x); break;
+    case 0xa8: y = a; SETNZ(y); break;
+    case 0x8a: a = x; SETNZ(a); break;
+    case 0x98: a = y; SETNZ(a); break;
+    case 0xba: x = s; SETNZ(x); break;
+    case 0x9a: s = x; break;
+    // stack
+    case 0x48: push(a); break;
+    case 0x68: a = pull(); SETNZ(a); break;
+    case 0x08: push(p | FLAG_B | FLAG_U); break;
+    case 0x28: p = (pull() & ~FLAG_B) | FLAG_U; break;
+    // logic
+#define LOGIC(base,OP) \
+    case base+0x09: a OP rd(pc++); SETNZ(a); break; \
+    case base+0x05: a OP rd(am_zp()); SETNZ(a); break; \
+    case base+0x15: a OP rd(am_zpx()); SETNZ(a); break; \
+    case base+0x0d: a OP rd(am_abs()); SETNZ(a); break; \
+    case base+0x1d: a OP rd(am_abx(1)); SETNZ(a); break; \
+    case base+0x19: a OP rd(am_aby(1)); SETNZ(a); break; \
+    case base+0x01: a OP rd(am_izx()); SETNZ(a); break; \
+    case base+0x11: a OP rd(am_izy(1)); SETNZ(a); break;
+    LOGIC(0x00, |=)
+    LOGIC(0x20, &=)
+    LOGIC(0x40, ^=)
+#undef LOGIC
+    // arithmetic
+#define ARITH(base,F) \
+    case base+0x09: F(rd(pc++)); break; \
+    case base+0x05: F(rd(am_zp())); break; \
+    case base+0x15: F(rd(am_zpx())); break; \
+    case base+0x0d: F(rd(am_abs())); break; \
+    case base+0x1d: F(rd(am_abx(1))); break; \
+    case base+0x19: F(rd(am_aby(1))); break; \
+    case base+0x01: F(rd(am_izx())); break; \
+    case base+0x11: F(rd(am_izy(1))); break;
+#define SBC(v) adc((byte)~(v))
+#define CMPA(v) cmp(a, (v))
+    ARITH(0x60, adc)
+    ARITH(0xe0, SBC)
+    ARITH(0xc0, CMPA)
+#undef ARITH
+    case 0xe0: cmp(x, rd(pc++)); break;
+    case 0xe4: cmp(x, rd(am_zp())); break;
+    case 0xec: cmp(x, rd(am_abs())); break;
+    case 0xc0: cmp(y, rd(pc++)); break;
+    case 0xc4: cmp(y, rd(am_zp())); break;
+    case 0xcc: cmp(y, rd(am_abs())); break;
+    case 0x24: case 0x2c:
+      v = rd(op == 0x24 ? am_zp() : am_abs());
+      p = (p & ~(FLAG_N|FLAG_V|FLAG_Z)) | (v & 0xc0) | ((a & v) ? 0 : FLAG_Z);
+      break;
+    // increments
+    case 0xe8: x++; SETNZ(x); break;
+    case 0xc8: y++; SETNZ(y); break;
+    case 0xca: x--; SETNZ(x); break;
+    case 0x88: y--; SETNZ(y); break;
+    case 0xe6: RMW(am_zp(), v++); break;
+    case 0xf6: RMW(am_zpx(), v++); break;
+    case 0xee: RMW(am_abs(), v++); break;
+    case 0xfe: RMW(am_abx(0), v++); break;
+    case 0xc6: RMW(am_zp(), v--); break;
+    case 0xd6: RMW(am_zpx(), v--); break;
+    case 0xce: RMW(am_abs(), v--); break;
+    case 0xde: RMW(am_abx(0), v--); break;
+    // shifts
+    case 0x0a: ASL(a); SETNZ(a); break;
+    case 0x4a: LSR(a); SETNZ(a); break;
+    case 0x2a: ROL(a); SETNZ(a); break;
+    case 0x6a: ROR(a); SETNZ(a); break;
+    case 0x06: RMW(am_zp(), ASL(v)); break;
+    case 0x16: RMW(am_zpx(), ASL(v)); break;
+    case 0x0e: RMW(am_abs(), ASL(v)); break;
+    case 0x1e: RMW(am_abx(0), ASL(v)); break;
+    case 0x46: RMW(am_zp(), LSR(v)); break;
+    case 0x56: RMW(am_zpx(), LSR(v)); break;
+    case 0x4e: RMW(am_abs(), LSR(v)); break;
+    case 0x5e: RMW(am_abx(0), LSR(v)); break;
+    case 0x26: RMW(am_zp(), ROL(v)); break;
+    case 0x36: RMW(am_zpx(), ROL(v)); break;
+    case 0x2e: RMW(am_abs(), ROL(v)); break;
+    case 0x3e: RMW(am_abx(0), ROL(v)); break;
+    case 0x66: RMW(am_zp(), ROR(v)); break;
+    case 0x76: RMW(am_zpx(), ROR(v)); break;
+    case 0x6e: RMW(am_abs(), ROR(v)); break;
+    case 0x7e: RMW(am_abx(0), ROR(v)); break;
+    // branches
+    case 0x10: branch(!(p & FLAG_N)); break;
+    case 0x30: branch(p & FLAG_N); break;
+    case 0x50: branch(!(p & FLAG_V)); break;
+    case 0x70: branch(p & FLAG_V); break;
+    case 0x90: branch(!(p & FLAG_C)); break;
+    case 0xb0: branch(p & FLAG_C); break;
+    case 0xd0: branch(!(p & FLAG_Z)); break;
+    case 0xf0: branch(p & FLAG_Z); break;
+    // jumps and calls
+    case 0x4c: pc = am_abs(); break;
+    case 0x6c:
+      ea = am_abs();	// 6502 page-wrap bug
+      pc = rd(ea) | (rd((ea & 0xff00) | ((ea+1) & 0xff)) << 8);
+      break;
+    case 0x20:
+      ea = am_abs();
+      pc--;
+      push(pc >> 8);
+      push(pc & 0xff);
+      pc = ea;
+      cycles += 6;
+      enter(symbol_at(ea));
+      return 0;
+    case 0x60:
+      pc = pull();
+      pc |= pull() << 8;
+      pc++;
+      cycles += 6;
+      leave();
+      return 0;
+    case 0x40:
+      p = (pull() & ~FLAG_B) | FLAG_U;
+      pc = pull();
+      pc |= pull() << 8;
+      cycles += 6;
+      leave();
+      if (in_nmi && depth <= nmi_depth) {
+        cur.nmi += cycles - nmi_start;
+        in_nmi = 0;
+      }
+      return 0;
+    case 0x00:
+      pc++;
+      interrupt(0xfffe, 1);
+      return 0;
+    // flags
+    case 0x18: p &= ~FLAG_C; break;
+    case 0x38: p |= FLAG_C; break;
+    case 0x58: p &= ~FLAG_I; break;
+    case 0x78: p |= FLAG_I; break;
+    case 0xb8: p &= ~FLAG_V; break;
+    case 0xd8: p &= ~FLAG_D; break;
+    case 0xf8: p |= FLAG_D; break;
+    case 0xea: break;
+    default:
+      fprintf(stderr, "unhandled opcode $%02x at $%04x\n", op, opc);
+      return -1;
+  }
+  cycles += CYCLES[op] + extra;
+  return CYCLES[op] + extra;
+}
+
+/// input scripts
+
+static const char* pad_script = "demo";
+static byte* pad_log;
+static long pad_log_len;
+
+static byte pad_for_frame(int frame) {
+  if (pad_log)
+    return frame < pad_log_len ? pad_log[frame] : 0;
+  if (!strcmp(pad_script, "none"))
+    return 0;
+  // sweep left and right every 96 frames, fire every other frame
+  return ((frame / 96) & 1 ? 0x40 : 0x80) | ((frame & 2) ? 0x01 : 0);
+}
+
+/// symbols
+
+static int by_addr(const void* a, const void* b) {
+  return ((const Symbol*)a)->addr - ((const Symbol*)b)->addr;
+}
+
+static void add_symbol(const char* name, unsigned addr) {
+  if (addr < 0x8000 || addr > 0xffff || nsyms == MAX_SYMS)
+    return;
+  // skip linker-generated segment and size symbols
+  if (!strncmp(name, "__", 2))
+    return;
+  syms[nsyms].addr = addr;
+  syms[nsyms].name = strdup(name);
+  nsyms++;
+}
+
+static void load_symbols(const char* path) {
+  FILE* f = fopen(path, "r");
+  char line[512];
+  int in_exports = 0;
+  if (!f) {
+    perror(path);
+    exit(1);
+  }
+  while (fgets(line, sizeof(line), f)) {
+    unsigned addr;
+    char name[256], name2[256], type[16], type2[16];
+    unsigned addr2;
+    if (sscanf(line, "al %x .%255s", &addr, name) == 2) {
+      add_symbol(name, addr & 0xffff);
+    } else if (strstr(line, "Exports list by")) {
+      in_exports = 1;
+    } else if (in_exports && strstr(line, "list")) {
+      in_exports = 0;
+    } else if (in_exports) {
+      int n = sscanf(line, "%255s %x %15s %255s %x %15s",
+                     name, &addr, type, name2, &addr2, type2);
+      if (n >= 3 && type[0] == 'R') add_symbol(name, addr);
+      if (n == 6 && type2[0] == 'R') add_symbol(name2, addr2);
+    }
+  }
+  fclose(f);
+  qsort(syms, nsyms, sizeof(Symbol), by_addr);
+}
+
+static void index_symbols(const char* idle_list) {
+  int i;
+  long addr;
+  for (addr=0; addr<0x10000; addr++)
+    sym_of_addr[addr] = -1;
+  for (i=0; i<nsyms; i++) {
+    long end = (i+1 < nsyms) ? syms[i+1].addr : 0x10000;
+    for (addr=syms[i].addr; addr<end; addr++)
+      sym_of_addr[addr] = i;
+    if (idle_list) {
+      const char* m = strstr(idle_list, syms[i].name);
+      size_t len = strlen(syms[i].name);
+      if (m && (m == idle_list || m[-1] == ',') &&
+          (m[len] == 0 || m[len] == ',')) {
+        syms[i].idle = 1;
+        idle_by_symbol = 1;
+      }
+    }
+  }
+}
+
+/// reports
+
+static int by_self(const void* a, const void* b) {
+  const Symbol* sa = *(const Symbol**)a;
+  const Symbol* sb = *(const Symbol**)b;
+  return (sb->self > sa->self) - (sb->self < sa->self);
+}
+
+static void report_profile(int skip, int top) {
+  static Symbol* list[MAX_SYMS+2];
+  unsigned long long total = 0;
+  int i, n = 0;
+  int counted = nframes - skip;
+  for (i=0; i<nsyms; i++)
+    if (syms[i].self) list[n++] = &syms[i];
+  if (unknown_sym.self) list[n++] = &unknown_sym;
+  if (nmi_sym.incl) list[n++] = &nmi_sym;
+  for (i=0; i<n; i++)
+    total += list[i]->self;
+  qsort(list, n, sizeof(Symbol*), by_self);
+  printf("Flat profile over %d frames (%llu cycles)\n\n", counted, total);
+  printf("  %%self   self/frame   incl/frame  max call  function\n");
+  for (i=0; i<n && i<top; i++) {
+    Symbol* sym = list[i];
+    printf("%6.2f%% %12.1f %12.1f %9lu  %s%s\n",
+           100.0 * sym->self / (total ? total : 1),
+           (double) sym->self / (counted ? counted : 1),
+           (double) sym->incl / (counted ? counted : 1),
+           sym->max_call, sym->name, sym->idle ? " (idle)" : "");
+  }
+  printf("\n");
+}
+
+static void report_frames(int skip, unsigned long budget, int worst) {
+  enum { BUCKETS = 16 };
+  unsigned long hist[BUCKETS+1] = {0};
+  unsigned long step = budget / 8;
+  unsigned long over = 0, maxbusy = 0, maxnmi = 0, maxvram = 0;
+  unsigned long long sumbusy = 0;
+  int i, j, counted = 0;
+  unsigned long maxh = 1;
+  static char picked[MAX_FRAMES];
+  for (i=skip; i<nframes; i++) {
+    FrameStat* f = &frames[i];
+    unsigned long b = f->busy / step;
+    hist[b < BUCKETS ? b : BUCKETS]++;
+    if (f->busy > budget) over++;
+    if (f->busy > maxbusy) maxbusy = f->busy;
+    if (f->nmi > maxnmi) maxnmi = f->nmi;
+    if (f->vram_vblank > maxvram) maxvram = f->vram_vblank;
+    sumbusy += f->busy;
+    counted++;
+  }
+  if (!counted) return;
+  for (i=0; i<=BUCKETS; i++)
+    if (hist[i] > maxh) maxh = hist[i];
+  printf("Per-frame busy cycles (budget %lu, %lu cycles per bucket)\n\n",
+         budget, step);
+  for (i=0; i<=BUCKETS; i++) {
+    int bar = (int)(hist[i] * 50 / maxh);
+    if (i < BUCKETS)
+      printf("%6lu-%-6lu %6lu %c", i*step, (i+1)*step-1, hist[i],
+             (i+1)*step > budget ? '!' : '|');
+    else
+      printf("%6lu+       %6lu %c", i*step, hist[i], '!');
+    for (j=0; j<bar; j++) putchar('#');
+    putchar('\n');
+  }
+  printf("\nframes %d, mean busy %.0f, max busy %lu, over budget %lu\n",
+         counted, (double) sumbusy / counted, maxbusy, over);
+  printf("max NMI cycles %lu, max VRAM bytes in vblank %lu\n\n",
+         maxnmi, maxvram);
+  // worst frames, with the functions that dominated each
+  printf("Worst frames\n\n");
+  for (j=0; j<worst; j++) {
+    int w = -1;
+    for (i=skip; i<nframes; i++)
+      if (!picked[i] && (w < 0 || frames[i].busy > frames[w].busy))
+        w = i;
+    if (w < 0) break;
+    printf("frame %5d busy %6lu nmi %5lu vram %3u:", w, frames[w].busy,
+           frames[w].nmi, frames[w].vram_vblank);
+    for (i=0; i<TOP_PER_FRAME && frames[w].top[i]; i++)
+      printf(" %s %lu", frames[w].top[i]->name, frames[w].top_cycles[i]);
+    putchar('\n');
+    picked[w] = 1;
+  }
+}
+
+// returns the number of caps exceeded
+static int check_caps(void) {
+  int i, j, over = 0;
+  if (ncaps)
+    printf("\nCycle caps (longest single call)\n\n");
+  for (i=0; i<ncaps; i++) {
+    Symbol* sym = NULL;
+    for (j=0; j<nsyms; j++)
+      if (!strcmp(syms[j].name, caps[i].name))
+        sym = &syms[j];
+    if (!sym) {
+      printf("%-24s not found\n", caps[i].name);
+      over++;
+      continue;
+    }
+    printf("%-24s %7lu / %-7lu %s\n", sym->name, sym->max_call,
+           caps[i].cycles, sym->max_call > caps[i].cycles ? "OVER" : "ok");
+    if (sym->max_call > caps[i].cycles)
+      over++;
+  }
+  return over;
+}
+
+static void write_csv(const char* path, int skip) {
+  FILE* f = fopen(path, "w");
+  int i;
+  if (!f) {
+    perror(path);
+    return;
+  }
+  fprintf(f, "frame,total,busy,nmi,vram_vblank,vram_render,top,top_cycles\n");
+  for (i=skip; i<nframes; i++) {
+    FrameStat* fs = &frames[i];
+    fprintf(f, "%d,%lu,%lu,%lu,%u,%u,%s,%lu\n", i, fs->total, fs->busy,
+            fs->nmi, fs->vram_vblank, fs->vram_render,
+            fs->top[0] ? fs->top[0]->name : "", fs->top_cycles[0]);
+  }
+  fclose(f);
+}
+
+/// main loop
+
+// advance the PPU by some dots and raise NMI at the start of vblank
+static void ppu_run(long dots) {
+  while (dots > 0) {
+    long vbl = (long)NTSC_VBLANK_LINE*NTSC_DOTS_PER_LINE + 1;
+    long frame = (long)NTSC_LINES*NTSC_DOTS_PER_LINE;
+    long pre = frame - NTSC_DOTS_PER_LINE + 1;
+    long next = ppu_dot < vbl ? vbl : ppu_dot < pre ? pre : frame;
+    long n = next - ppu_dot;
+    if (n > dots) n = dots;
+    ppu_dot += n;
+    dots -= n;
+    if (ppu_dot == vbl) {
+      ppu_status |= 0x80;
+      if (ppu_ctrl & 0x80)
+        nmi_pending = 1;
+    } else if (ppu_dot == pre) {
+      ppu_status &= ~0xe0;
+    } else if (ppu_dot == frame) {
+      ppu_dot = 0;
+    }
+  }
+}
+
+static void usage(void) {
+  fprintf(stderr,
+    "usage: nesprof [options] rom.nes\n"
+    "  -l file   cc65 label file (ld65 -Ln) or map file (ld65 -m)\n"
+    "  -n N      frames to run (default 600)\n"
+    "  -s N      boot frames to leave out of the report (default 16)\n"
+    "  -b N      busy-cycle budget per frame (default %d)\n"
+    "  -w list   comma-separated idle symbols\n"
+    "            (default _ppu_wait_frame,_ppu_wait_nmi)\n"
+    "  -p name   input script: demo (default) or none\n"
+    "  -i file   input log, one pad byte per frame\n"
+    "  -t N      functions in the flat profile (default 30)\n"
+    "  -f N      worst frames to list (default 10)\n"
+    "  -c file   write per-frame CSV\n"
+    "  -x name=N cap on the longest call of a function, in cycles;\n"
+    "            exit status 1 if exceeded (up to %d caps)\n",
+    NTSC_FRAME_CYCLES, MAX_CAPS);
+  exit(2);
+}
+
+int main(int argc, char** argv) {
+  const char* labels = NULL;
+  const char* idle = "_ppu_wait_frame,_ppu_wait_nmi";
+  const char* csv = NULL;
+  int run = 600, skip = 16, top = 30, worst = 10;
+  unsigned long budget = NTSC_FRAME_CYCLES;
+  FILE* f;
+  byte hdr[16];
+  int i;
+  for (i=1; i<argc-1; i++) {
+    if (argv[i][0] != '-') usage();
+    switch (argv[i][1]) {
+      case 'l': labels = argv[++i]; break;
+      case 'n': run = atoi(argv[++i]); break;
+      case 's': skip = atoi(argv[++i]); break;
+      case 'b': budget = strtoul(argv[++i], NULL, 0); break;
+      case 'w': idle = argv[++i]; break;
+      case 'p': pad_script = argv[++i]; break;
+      case 'i': {
+        FILE* pf = fopen(argv[++i], "rb");
+        if (!pf) { perror(argv[i]); return 1; }
+        pad_log = malloc(MAX_FRAMES);
+        pad_log_len = fread(pad_log, 1, MAX_FRAMES, pf);
+        fclose(pf);
+        break;
+      }
+      case 't': top = atoi(argv[++i]); break;
+      case 'f': worst = atoi(argv[++i]); break;
+      case 'c': csv = argv[++i]; break;
+      case 'x': {
+        char* eq = strchr(argv[++i], '=');
+        if (!eq || ncaps == MAX_CAPS) usage();
+        *eq = 0;
+        caps[ncaps].name = argv[i];
+        caps[ncaps].cycles = strtoul(eq+1, NULL, 0);
+        ncaps++;
+        break;
+      }
+      default: usage();
+    }
+  }
+  if (i != argc-1) usage();
+  if (run > MAX_FRAMES) run = MAX_FRAMES;
+  if (skip >= run) skip = 0;
+  skip_frames = skip;
+
+  f = fopen(argv[argc-1], "rb");
+  if (!f) {
+    perror(argv[argc-1]);
+    return 1;
+  }
+  if (fread(hdr, 1, 16, f) != 16 || memcmp(hdr, "NES\x1a", 4)) {
+    fprintf(stderr, "not an iNES image\n");
+    return 1;
+  }
+  prg_banks = hdr[4];
+  mapper = (hdr[6] >> 4) | (hdr[7] & 0xf0);
+  if (mapper != 0 && mapper != 2) {
+    fprintf(stderr, "mapper %d not supported\n", mapper);
+    return 1;
+  }
+  if (hdr[6] & 4)
+    fseek(f, 512, SEEK_CUR);	// trainer
+  prg = malloc(prg_banks * 0x4000);
+  if (fread(prg, 1, prg_banks * 0x4000, f) != (size_t)prg_banks * 0x4000) {
+    fprintf(stderr, "truncated PRG ROM\n");
+    return 1;
+  }
+  fclose(f);
+
+  if (labels)
+    load_symbols(labels);
+  index_symbols(idle);
+  frames = calloc(MAX_FRAMES, sizeof(FrameStat));
+
+  // power on
+  s = 0xfd;
+  p = FLAG_I | FLAG_U;
+  pc = rd16(0xfffc);
+  pad_state = pad_for_frame(0);
+
+  while (nframes < run) {
+    word opc = pc;
+    // attribute cycles to the function containing the PC
+    Symbol* sym = symbol_at(opc);
+    unsigned long long before = cycles;
+    long dots;
+    int spin;
+    if (step() < 0)
+      break;
+    dots = (long)(cycles - before) * 3;
+    spin = (opc >= spin_lo && opc <= spin_hi);
+    if (!(spin_lo <= pc && pc <= spin_hi))
+      spin_lo = spin_hi = 0;
+    sym->self += cycles - before;
+    sym->frame_self += cycles - before;
+    cur.total += cycles - before;
+    if (idle_by_symbol ? !sym->idle : !spin)
+      cur.busy += cycles - before;
+    ppu_run(dots);
+    if (nmi_pending) {
+      nmi_pending = 0;
+      end_frame();
+      nmi_start = cycles;
+      nmi_depth = depth;
+      in_nmi = 1;
+      interrupt(0xfffa, 0);
+      ppu_run(7*3);
+      cur.total += 7;
+      cur.busy += 7;
+      enter(&nmi_sym);
+    }
+  }
+  report_profile(skip, top);
+  report_frames(skip, budget, worst);
+  if (csv)
+    write_csv(csv, skip);
+  return check_caps() ? 1 : 0;
+}
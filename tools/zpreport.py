@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+"""
+Zero page budget report for the cc65/ld65 NES build.
+
+Reads the ld65 map file (ld65 -m shoot2.map) and prints how many
+zero page bytes the game, neslib and the cc65 runtime each use,
+per segment, and how much of the ZP memory area is still free.
+
+    python3 tools/zpreport.py -c shoot2.cfg shoot2.map
+    python3 tools/zpreport.py -v --min-free 16 shoot2.map
+
+With -c, the ZP area size and the list of zero page segments come
+from the linker config (segments with type = zp); otherwise the
+shoot2.cfg defaults are used ($0002-$00FC; ZEROPAGE, EXTZP, HOTZP).
+Other memory areas in zero page are reserved for one owner, such as
+FTZP for FamiTone2's scratch bytes, and count as that owner's use.
+With -v, zero page symbols are listed by address.
+"""
+
+import argparse
+import re
+import sys
+
+DEFAULT_ZP_START = 0x02
+DEFAULT_ZP_SIZE = 0xfb
+DEFAULT_ZP_SEGMENTS = ["ZEROPAGE", "EXTZP", "HOTZP"]
+# zero page memory areas outside ZP: name -> (start, size)
+DEFAULT_ZP_RESERVED = {"FTZP": (0xfd, 3)}
+# their owners; any other area is the game's
+RESERVED_OWNERS = {"FTZP": "neslib"}	# FamiTone2 (music.s)
+
+# module name -> owner; first match wins, anything else is the game
+OWNERS = [
+    ("neslib", re.compile(r"crt0|neslib|famitone|nesdoug", re.I)),
+    ("cc65 runtime", re.compile(r"(^|[/\\])(nes|runtime|none)\.lib\(", re.I)),
+]
+
+
+def parse_int(s):
+    s = s.strip()
+    if s.startswith("$"):
+        return int(s[1:], 16)
+    return int(s, 0)
+
+
+def read_cfg(path):
+    """Return (zp start, zp size, zp segment names, reserved areas)
+    from a linker config."""
+    text = re.sub(r"#.*", "", open(path).read())
+    start, size = DEFAULT_ZP_START, DEFAULT_ZP_SIZE
+    reserved = {}
+    m = re.search(r"\bMEMORY\s*\{(.*?)\}", text, re.S)
+    for name, body in re.findall(r"\b(\w+)\s*:\s*([^;]*);",
+                                 m.group(1) if m else ""):
+        attrs = dict((k, v.strip()) for k, v in
+                     re.findall(r"(\w+)\s*=\s*([^,;]+)", body))
+        if "start" not in attrs or attrs.get("file") != '""':
+            continue
+        a_start = parse_int(attrs["start"])
+        a_size = parse_int(attrs.get("size", "0"))
+        if name == "ZP":
+            start, size = a_start, a_size
+        elif a_start < 0x100:
+            reserved[name] = (a_start, a_size)
+    segs = [name for name, body in
+            re.findall(r"\b(\w+)\s*:\s*([^;]*);", text)
+            if re.search(r"type\s*=\s*zp\b", body)]
+    return start, size, segs or DEFAULT_ZP_SEGMENTS, reserved
+
+
+def read_map(path):
+    """Return ({module: {segment: size}}, [(name, addr)] zp exports)."""
+    modules = {}
+    exports = []
+    section = None
+    module = None
+    for line in open(path, errors="replace"):
+        line = line.rstrip("\n")
+        if line.startswith("Modules list"):
+            section = "modules"
+            continue
+        if line.startswith("Segment list"):
+            section = None
+            continue
+        if line.startswith("Exports list by name"):
+            section = "exports"
+            continue
+        if line.startswith("Exports list by value") or \
+           line.startswith("Imports list"):
+            section = None
+            continue
+        if section == "modules":
+            if line and not line.startswith(" ") and line.endswith(":"):
+                module = line[:-1]
+                modules.setdefault(module, {})
+                continue
+            m = re.match(r"\s+(\w+)\s+Offs=\w+\s+Size=([0-9A-Fa-f]+)", line)
+            if m and module is not None:
+                seg = modules[module]
+                seg[m.group(1)] = seg.get(m.group(1), 0) + int(m.group(2), 16)
+        elif section == "exports":
+            # two "name value flags" entries per line
+            for name, value, flags in re.findall(
+                    r"(\S+)\s+([0-9A-Fa-f]{6})\s+(\w+)", line):
+                if "Z" in flags:
+                    exports.append((name, int(value, 16)))
+    return modules, exports
+
+
+def owner_of(module):
+    for owner, pattern in OWNERS:
+        if pattern.search(module):
+            return owner
+    return "game"
+
+
+def main():
+    ap = argparse.ArgumentParser(description="zero page budget report")
+    ap.add_argument("mapfile")
+    ap.add_argument("-c", "--cfg", help="ld65 config (ZP size, zp segments)")
+    ap.add_argument("-v", "--verbose", action="store_true",
+                    help="list modules and zero page symbols")
+    ap.add_argument("--min-free", type=int, default=0,
+                    help="exit with status 1 if fewer bytes are free")
+    args = ap.parse_args()
+
+    if args.cfg:
+        zp_start, zp_size, zp_segs, reserved = read_cfg(args.cfg)
+    else:
+        zp_start, zp_size, zp_segs, reserved = \
+            DEFAULT_ZP_START, DEFAULT_ZP_SIZE, DEFAULT_ZP_SEGMENTS, \
+            DEFAULT_ZP_RESERVED
+    modules, exports = read_map(args.mapfile)
+    if not modules:
+        sys.exit("%s: no modules list (link with ld65 -m)" % args.mapfile)
+
+    # owner -> segment -> bytes
+    usage = {}
+    per_module = []
+    for module, segs in modules.items():
+        owner = owner_of(module)
+        for seg, size in segs.items():
+            if seg in zp_segs and size:
+                o = usage.setdefault(owner, {})
+                o[seg] = o.get(seg, 0) + size
+                per_module.append((owner, module, seg, size))
+    for name, (start, size) in reserved.items():
+        o = usage.setdefault(RESERVED_OWNERS.get(name, "game"), {})
+        o[name] = o.get(name, 0) + size
+
+    print("zero page: %d bytes ($%04X-$%04X), segments %s" %
+          (zp_size, zp_start, zp_start + zp_size - 1, ", ".join(zp_segs)))
+    for name, (start, size) in sorted(reserved.items(),
+                                      key=lambda r: r[1]):
+        print("reserved:  %d bytes ($%04X-$%04X), %s" %
+              (size, start, start + size - 1, name))
+    print()
+    print("%-16s %5s" % ("owner", "bytes"))
+    total = 0
+    for owner in ("cc65 runtime", "neslib", "game"):
+        segs = usage.get(owner, {})
+        n = sum(segs.values())
+        total += n
+        print("%-16s %5d" % (owner, n))
+        for seg in sorted(segs):
+            print("  %-14s %5d" % (seg, segs[seg]))
+    free = zp_size + sum(size for start, size in reserved.values()) - total
+    print("%-16s %5d" % ("free", free))
+
+    if args.verbose:
+        print()
+        print("%-16s %-10s %s" % ("owner", "segment", "module"))
+        for owner, module, seg, size in sorted(per_module):
+            print("%-16s %-10s %s (%d)" % (owner, seg, module, size))
+        if exports:
+            print()
+            for name, addr in sorted(exports, key=lambda e: (e[1], e[0])):
+                print("  $%02X  %s" % (addr, name))
+
+    if free < args.min_free:
+        sys.stderr.write("zpreport: only %d bytes free, need %d\n" %
+                         (free, args.min_free))
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -1,49 +1,174 @@
 
+#include <nes.h>
 #include "neslib.h"
 #include "vrambuf.h"
 #include <string.h>
 
-// index to end of buffer
-byte updptr = 0;
+//#link "vrambuf.s"
+
+// updbuf and updptr live in zero page (hotzp.s)
+
+// vblank cost per frame the NMI is allowed to drain
+byte vrambuf_budget = VRAMBUF_BUDGET;
+byte vrambuf_spent;
+
+// attribute table of NAMETABLE_A, as queued so far
+byte vrambuf_attr[64];
+
+// how vrambuf_flush() waits for the next frame
+void (*vrambuf_wait)(void) = ppu_wait_frame;
+
+// running byte counters
+VRAMBufStats vrambuf_stats;
+
+// front buffer, drained by the NMI when ready is set
+static byte* front;
+static volatile byte ready;
+
+// decode a buffer to the PPU (vrambuf.s); it must be in page 1
+void __fastcall__ vrambuf_drain(const byte* buf);
 
 // add EOF marker to buffer (but don't increment pointer)
 void vrambuf_end(void) {
   VRAMBUF_SET(NT_UPD_EOF);
 }
 
-// clear vram buffer and place EOF marker
+// clear both buffers
 void vrambuf_clear(void) {
+  ready = 0;
+  updbuf = VRAMBUF0;
   updptr = 0;
+  vrambuf_spent = 0;
   vrambuf_end();
 }
 
-// wait for next frame, then clear buffer
-// this assumes the NMI will call flush_vram_update()
+// hand the back buffer to the NMI, wait for next frame
 void vrambuf_flush(void) {
   // make sure buffer has EOF marker
   vrambuf_end();
-  // wait for next frame to flush update buffer
-  // this will also set the scroll registers properly
-  ppu_wait_frame();
-  // clear the buffer
-  vrambuf_clear();
+  // publish back buffer, and swap to the other one
+  front = updbuf;
+  ready = 1;
+  updbuf = (updbuf == VRAMBUF0) ? VRAMBUF1 : VRAMBUF0;
+  // wait for next frame; the NMI drains the front buffer
+  vrambuf_wait();
+  updptr = vrambuf_spent = 0;
+  vrambuf_end();
 }
 
-// add multiple characters to update buffer
-// using horizontal increment
-void vrambuf_put(word addr, register const char* str, byte len) {
-  // if bytes won't fit, wait for vsync and flush buffer
-  if (VBUFSIZE-4-len < updptr) {
+// account for a write of size buffer bytes (at most
+// VBUFSIZE-1); over the vblank budget it still goes out,
+// next frame if the buffer itself is full
+static void vrambuf_room(byte size, byte cost) {
+  if (vrambuf_spent + cost > vrambuf_budget) {
+    vrambuf_stats.overflowed += size;
+  }
+  // whatever the budget, the write and the EOF mark must fit
+  if (updptr + size + 1 > VBUFSIZE) {
     vrambuf_flush();
   }
-  // add vram address
-  VRAMBUF_ADD((addr >> 8) ^ NT_UPD_HORZ);
+  vrambuf_spent += cost;
+  vrambuf_stats.queued += size;
+}
+
+// header: address (high byte with the flags), low byte, length
+static void vrambuf_header(word addr, byte len) {
+  VRAMBUF_ADD(addr >> 8);
   VRAMBUF_ADD(addr); // only lower 8 bits
-  // add length
   VRAMBUF_ADD(len);
-  // add data to buffer
-  memcpy(updbuf+updptr, str, len);
-  updptr += len;
-  // place EOF mark
+}
+
+// literal run; addr carries the direction flag. Runs longer
+// than VRAMBUF_MAXRUN go out in pieces, a buffer each
+static void vrambuf_run(word addr, register const char* str, byte len) {
+  byte n;
+  while (len) {
+    n = len < VRAMBUF_MAXRUN ? len : VRAMBUF_MAXRUN;
+    vrambuf_room(n + 3, n + 3);
+    vrambuf_header(addr, n);
+    memcpy(updbuf+updptr, str, n);
+    updptr += n;
+    str += n;
+    len -= n;
+    addr += (addr & VRAMBUF_VERT) ? n*32 : n;
+  }
+  vrambuf_end();
+}
+
+// add multiple characters to update buffer
+// using horizontal increment
+void vrambuf_put(word addr, const char* str, byte len) {
+  vrambuf_run(addr ^ (NT_UPD_HORZ << 8), str, len);
+}
+
+// column of len characters
+void vrambuf_put_vert(word addr, const char* str, byte len) {
+  vrambuf_run(addr | VRAMBUF_VERT, str, len);
+}
+
+// len copies of value, across or down (VRAMBUF_FILL_VERT)
+void vrambuf_fill(word addr, byte value, byte len) {
+  vrambuf_room(4, VRAMBUF_FILL_COST(len & ~VRAMBUF_FILL_VERT));
+  vrambuf_header(addr | VRAMBUF_FILL, len);
+  VRAMBUF_ADD(value);
   vrambuf_end();
 }
+
+// set the palette of the 16x16 area holding tile (x,y)
+void vrambuf_put_attr(byte x, byte y, byte pal) {
+  byte i = (y >> 2) * 8 + (x >> 2);
+  // 2 bits per 16x16 area: right adds 2, bottom adds 4
+  byte shift = ((y & 2) << 1) | (x & 2);
+  byte mask = 3 << shift;
+  byte a = (vrambuf_attr[i] & ~mask) | ((pal << shift) & mask);
+  if (a == vrambuf_attr[i])
+    return;
+  vrambuf_attr[i] = a;
+  // a single-byte write: address with no flags, then the byte
+  vrambuf_room(3, 3);
+  VRAMBUF_ADD((NAMETABLE_A + 0x3c0) >> 8);
+  VRAMBUF_ADD(0xc0 + i);
+  VRAMBUF_ADD(a);
+  vrambuf_end();
+}
+
+// put only the spans of str that differ from shadow,
+// then update shadow to match
+void vrambuf_put_diff(word addr, register const char* str, char* shadow,
+                      byte len) {
+  register byte i = 0;
+  byte start, end;
+  while (i < len) {
+    // skip unchanged bytes
+    if (str[i] == shadow[i]) {
+      ++i;
+      continue;
+    }
+    // grow the run, bridging gaps too short to pay for a header
+    start = i;
+    end = ++i;
+    while (i < len) {
+      if (str[i] != shadow[i])
+        end = i+1;
+      else if (i >= end + VRAMBUF_DIFFGAP-1)
+        break;
+      ++i;
+    }
+    memcpy(shadow+start, str+start, end-start);
+    vrambuf_put(addr+start, str+start, end-start);
+    i = end;
+  }
+}
+
+// NMI callback that drains the front buffer
+void __fastcall__ vrambuf_nmi(void) {
+  if (ready) {
+    vrambuf_drain(front);
+    ready = 0;
+    // neslib already set the scroll for this frame,
+    // and our VRAM writes clobbered it
+    PPU.scroll = 0;
+    PPU.scroll = 0;
+    PPU.control = get_ppu_ctrl_var();
+  }
+}
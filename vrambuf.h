@@ -4,14 +4,48 @@
 
 #include "neslib.h"
 
-// VBUFSIZE = maximum update buffer bytes
-#define VBUFSIZE 128
+// VBUFSIZE = maximum update buffer bytes (per buffer)
+#define VBUFSIZE 96
 
-// update buffer starts at $100 (stack page)
-#define updbuf ((byte*)0x100)
+// the two update buffers live in the stack page,
+// $100-$1BF, below neslib's palette buffer at $1C0
+#define VRAMBUF0 ((byte*)0x100)
+#define VRAMBUF1 ((byte*)(0x100+VBUFSIZE))
 
-// index to end of buffer
+// longest run sent in one piece: a whole buffer with its
+// header and EOF mark (longer puts are split)
+#define VRAMBUF_MAXRUN (VBUFSIZE-4)
+
+// default vblank byte budget (headers included)
+#define VRAMBUF_BUDGET 64
+
+// back buffer, filled by game logic
+// (zero page, so VRAMBUF_ADD is a (zp),y store)
+extern byte* updbuf;
+#pragma zpsym ("updbuf")
+
+// index to end of back buffer
 extern byte updptr;
+#pragma zpsym ("updptr")
+
+// vblank cost per frame the NMI is allowed to drain, in
+// literal bytes (a header is 3, a fill byte 1/2)
+extern byte vrambuf_budget;
+
+// cost queued so far for the next frame
+extern byte vrambuf_spent;
+
+// how vrambuf_flush() waits for the next frame
+// (ppu_wait_frame, or telemetry's timed wait)
+extern void (*vrambuf_wait)(void);
+
+// running byte counters (wrap around)
+typedef struct {
+  word queued;		// bytes placed in a back buffer
+  word overflowed;	// bytes queued over the budget
+} VRAMBufStats;
+
+extern VRAMBufStats vrambuf_stats;
 
 // C versions of macros
 #define VRAMBUF_SET(b) updbuf[updptr] = (b);
@@ -23,21 +57,66 @@ extern byte updptr;
   VRAMBUF_ADD(addr);\
   VRAMBUF_ADD(len);
 
+// does a len-byte run fit in this frame's budget? Writes
+// over it still go out, but may wait for vsync when the
+// buffer is full; callers that mustn't wait (the HUD,
+// screen_stream) check this first and try again next frame
+#define VRAMBUF_FITS(len) (vrambuf_spent + (len) + 3 <= vrambuf_budget)
+
 // OR with address to put vertical run
 #define VRAMBUF_VERT	0x8000
 
+// OR with address for a fill: MSB|$C0, LSB, LEN, byte
+// (the palette can't be filled: $FF is the EOF marker)
+#define VRAMBUF_FILL	0xc000
+
+// OR with a fill's length to fill down a column
+#define VRAMBUF_FILL_VERT 0x80
+
+// vblank cost of a len-byte fill, and does it fit?
+#define VRAMBUF_FILL_COST(len) (4 + ((len) >> 1))
+#define VRAMBUF_FITS_FILL(len) \
+  (vrambuf_spent + VRAMBUF_FILL_COST(len) <= vrambuf_budget)
+
 // add EOF marker to buffer (but don't increment pointer)
 void vrambuf_end(void);
 
-// clear vram buffer and place EOF marker
+// clear both buffers
 void vrambuf_clear(void);
 
-// wait for next frame, then clear buffer
-// this assumes the NMI will call flush_vram_update()
+// hand the back buffer to the NMI, wait for next frame
 void vrambuf_flush(void);
 
 // add multiple characters to update buffer
-// using horizontal increment
+// using horizontal increment (split every VRAMBUF_MAXRUN)
 void vrambuf_put(word addr, const char* str, byte len);
 
+// column of len (1-255) characters
+// (split every VRAMBUF_MAXRUN, like vrambuf_put)
+void vrambuf_put_vert(word addr, const char* str, byte len);
+
+// len (1-127) copies of value, across or down
+void vrambuf_fill(word addr, byte value, byte len);
+#define vrambuf_fill_vert(addr,value,len) \
+  vrambuf_fill(addr, value, (len)|VRAMBUF_FILL_VERT)
+
+// attribute table of NAMETABLE_A, as queued so far
+extern byte vrambuf_attr[64];
+
+// set the palette (0-3) of the 16x16 area holding tile (x,y)
+// of NAMETABLE_A: a one-byte write, only if it changed
+void vrambuf_put_attr(byte x, byte y, byte pal);
+
+// unchanged bytes it takes to split a diff into two runs
+// (a run header costs 3 bytes)
+#define VRAMBUF_DIFFGAP 3
+
+// put only the spans of str that differ from shadow,
+// then update shadow to match
+void vrambuf_put_diff(word addr, const char* str, char* shadow, byte len);
+
+// NMI callback that drains the front buffer (vrambuf.s
+// decodes it; install with nmi_set_callback)
+void __fastcall__ vrambuf_nmi(void);
+
 #endif // vrambuf.h
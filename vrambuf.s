@@ -0,0 +1,179 @@
+;
+; VRAM update buffer consumer, run from the NMI by vrambuf_nmi.
+; Replaces neslib's flush_vram_update, adding fills (see
+; vrambuf.h). Each op starts with the address high byte, whose
+; top two bits pick the op:
+;   $00 MSB, LSB, byte			single byte
+;   $40 MSB, LSB, LEN, LEN bytes	run across (NT_UPD_HORZ)
+;   $80 MSB, LSB, LEN, LEN bytes	run down (NT_UPD_VERT)
+;   $C0 MSB, LSB, LEN, byte		fill, down if LEN bit 7
+;   $FF					end of buffer (NT_UPD_EOF)
+;
+; Both buffers are in the stack page, so the buffer is read
+; with PLA ("popslide"): S points just below it while it
+; drains and goes back before returning. Only the NMI may run
+; it, before band_nmi's CLI: an interrupt would push over the
+; unread buffer. Runs and fills jump into unrolled blocks of
+; UNROLL copies with RTS, whose two pushes land on header bytes
+; already read.
+;
+; Cycles, JSR to RTS (measured on a 6502 model):
+;   call		70
+;   single byte		31
+;   run			90 an op + 8 a byte (+18 a block past 32)
+;   fill		100 an op + 4 a byte (+20 a block past 32)
+; A full buffer of three 29-byte runs drains in 1033 cycles
+; (1536 with the old indexed loop). The scroll is left to
+; the caller.
+;
+
+.export _vrambuf_drain
+.import _get_ppu_ctrl_var
+
+PPU_CTRL	= $2000
+PPU_ADDR	= $2006
+PPU_DATA	= $2007
+
+UNROLL		= 32		; bytes per unrolled block
+
+.segment "BSS"
+
+ctrl:	.res 1			; PPU_CTRL with +1 increment
+saved_s: .res 1			; caller's stack pointer
+
+.segment "CODE"
+
+; void __fastcall__ vrambuf_drain(const byte* buf);
+_vrambuf_drain:
+	tay			; buffer low byte
+	jsr _get_ppu_ctrl_var
+	and #$fb
+	sta ctrl
+	tsx
+	stx saved_s
+	dey			; PLA reads $100 + S + 1
+	tya
+	tax
+	txs
+op:
+	pla
+	cmp #$40
+	bcs @multi
+	; single byte
+	sta PPU_ADDR
+	pla
+	sta PPU_ADDR
+	pla
+	sta PPU_DATA
+	bcc op			; always (C from the CMP)
+@multi:
+	cmp #$ff
+	beq done
+	tay
+	and #$3f
+	sta PPU_ADDR
+	pla
+	sta PPU_ADDR
+	lda ctrl
+	cpy #$c0
+	bcs fill
+	cpy #$80
+	bcc @across
+	ora #4			; +32 increment
+@across:
+	sta PPU_CTRL
+	pla			; LEN, 1-255
+	tax			; bytes left
+	jmp copy_more
+
+done:
+	ldx saved_s
+	txs
+	rts
+
+fill:
+	tax			; ctrl
+	pla			; LEN, bit 7 = down
+	tay
+	txa
+	cpy #$80
+	bcc @across
+	ora #4
+@across:
+	sta PPU_CTRL
+	tya
+	and #$7f
+	tax			; bytes left
+	pla			; byte
+	tay
+	jmp fill_more
+
+copy_block:
+.repeat UNROLL
+	pla
+	sta PPU_DATA
+.endrepeat
+copy_end:
+	txa
+	bne copy_more
+	jmp op
+copy_more:
+	cpx #UNROLL
+	bcc @part
+	txa
+	sbc #UNROLL		; C set
+	tax
+	jmp copy_block
+@part:
+	lda COPY_HI,x		; last X copies of the block
+	pha
+	lda COPY_LO,x
+	pha
+	ldx #0
+	rts
+
+fill_block:
+.repeat UNROLL
+	sta PPU_DATA
+.endrepeat
+fill_end:
+	txa
+	bne fill_more
+	jmp op
+fill_more:
+	cpx #UNROLL
+	bcc @part
+	txa
+	sbc #UNROLL		; C set
+	tax
+	tya
+	jmp fill_block
+@part:
+	lda FILL_HI,x
+	pha
+	lda FILL_LO,x
+	pha
+	ldx #0
+	tya
+	rts
+
+.segment "RODATA"
+
+; entry points (minus 1, for RTS) for the last n copies
+; of each block
+COPY_LO:
+.repeat UNROLL, n
+	.byte <(copy_end - 4*n - 1)
+.endrepeat
+COPY_HI:
+.repeat UNROLL, n
+	.byte >(copy_end - 4*n - 1)
+.endrepeat
+FILL_LO:
+.repeat UNROLL, n
+	.byte <(fill_end - 3*n - 1)
+.endrepeat
+FILL_HI:
+.repeat UNROLL, n
+	.byte >(fill_end - 3*n - 1)
+.endrepeat